@@ -165,6 +165,14 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples needed to fill one stream buffer
+    ///
+    /// \return Number of samples, for all the channels
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBufferSampleCount() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
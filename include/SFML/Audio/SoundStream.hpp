@@ -32,12 +32,18 @@
 #include <SFML/Audio/SoundSource.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
-#include <SFML/System/Mutex.hpp>
+#include <SFML/System/FastMutex.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class SoundStreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -178,6 +184,71 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers queued by the stream
+    ///
+    /// More buffers make the stream more robust against slow
+    /// decoding or a busy system, at the cost of more memory.
+    /// The new value is taken into account the next time the
+    /// stream starts playing.
+    /// The default number of buffers is 3.
+    ///
+    /// \param count Number of buffers, at least 2
+    ///
+    /// \see getBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers queued by the stream
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of audio that each buffer should contain
+    ///
+    /// The stream source decides how much audio it provides in
+    /// each chunk; this is a hint that it should follow (sf::Music
+    /// does). Shorter buffers reduce the memory consumption and
+    /// the latency of seeking, longer buffers need less work.
+    /// The default duration is 1 second.
+    ///
+    /// \param duration Duration of audio per buffer
+    ///
+    /// \see getBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio that each buffer should contain
+    ///
+    /// \return Duration of audio per buffer
+    ///
+    /// \see setBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getBufferDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of times the stream ran out of audio data
+    ///
+    /// An underrun happens when the stream source doesn't provide
+    /// audio data fast enough: the playback stops until new data
+    /// is available, which is audible. If this happens, try to
+    /// increase the number or the duration of the buffers.
+    ///
+    /// \return Number of underruns since the stream was created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getUnderrunCount() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -236,14 +307,28 @@ protected:
 
 private:
 
+    friend class priv::SoundStreamScheduler;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Run one iteration of the streaming loop
+    ///
+    /// This function is called regularly by the thread shared
+    /// by all the streams, until it returns false.
+    ///
+    /// \param nextUpdate Filled with the maximum time to wait before the next call
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// \return True if the stream is still streaming, false if it is finished
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    bool updateStream(Time& nextUpdate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the playback and destroy the audio buffers
+    ///
+    /// This function does nothing if the buffers don't exist.
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseBuffers();
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -253,7 +338,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, buffer count[)
     ///
     /// \return True if the stream source has requested to stop, false otherwise
     ///
@@ -279,25 +364,24 @@ private:
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
-    enum
-    {
-        BufferCount = 3 ///< Number of audio buffers used by the streaming loop
-    };
-
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    mutable Mutex m_threadMutex;             ///< Thread mutex
-    Status        m_threadStartState;        ///< State the thread starts in (Playing, Paused, Stopped)
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    bool          m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    mutable FastMutex         m_threadMutex;      ///< Mutex protecting the streaming state
+    Status                    m_threadStartState; ///< State the streaming starts in (Playing, Paused, Stopped)
+    bool                      m_isStreaming;      ///< Streaming state (true = playing, false = stopped)
+    std::vector<unsigned int> m_buffers;          ///< Sound buffers used to store temporary audio data
+    unsigned int              m_channelCount;     ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int              m_sampleRate;       ///< Frequency (samples / second)
+    Uint32                    m_format;           ///< Format of the internal sound buffers
+    bool                      m_loop;             ///< Loop flag (true to loop, false to play once)
+    Uint64                    m_samplesProcessed; ///< Number of buffers processed since beginning of the stream
+    std::vector<bool>         m_endBuffers;       ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    unsigned int              m_bufferCount;      ///< Number of buffers to use for the next playback
+    Time                      m_bufferDuration;   ///< Duration of audio per buffer requested to the source
+    bool                      m_requestStop;      ///< Did the source request to stop streaming?
+    Uint64                    m_queuedSamples;    ///< Number of samples in the buffers waiting to be played
+    unsigned int              m_underrunCount;    ///< Number of times the playback ran out of data
 };
 
 } // namespace sf
@@ -331,12 +415,14 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
-/// It is important to keep this in mind, because you may have to take
-/// care of synchronization issues if you share data between threads.
+/// It is important to note that SoundStreams are played in a
+/// separate thread (shared by all the streams), so that the streaming
+/// loop doesn't block the rest of the program. In particular, the
+/// OnGetData and OnSeek virtual functions may sometimes be called
+/// from this separate thread. It is important to keep this in mind,
+/// because you may have to take care of synchronization issues if
+/// you share data between threads. Since the thread serves all the
+/// streams, onGetData should return quickly.
 ///
 /// Usage example:
 /// \code
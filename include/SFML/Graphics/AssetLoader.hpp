@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ASSETLOADER_HPP
+#define SFML_ASSETLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct AssetLoaderState;
+}
+
+class Image;
+class Texture;
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Load images and textures in the background
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AssetLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to the result of a load request
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Future
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Status of a load request
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Status
+        {
+            Invalid, ///< The future is not attached to any request
+            Pending, ///< The asset is not loaded yet
+            Ready,   ///< The asset was loaded successfully
+            Failed   ///< The asset couldn't be loaded, or the request was canceled
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Constructs a future which is not attached to any request.
+        ///
+        ////////////////////////////////////////////////////////////
+        Future();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// \param copy Instance to copy
+        ///
+        ////////////////////////////////////////////////////////////
+        Future(const Future& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Future();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Overload of assignment operator
+        ///
+        /// \param right Instance to assign
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        Future& operator =(const Future& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the current status of the request
+        ///
+        /// \return Status of the request
+        ///
+        ////////////////////////////////////////////////////////////
+        Status getStatus() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Wait until the request is complete
+        ///
+        /// Texture requests only complete after their upload,
+        /// so don't wait for one on the thread that is supposed
+        /// to call AssetLoader::upload.
+        ///
+        /// \return Final status of the request (Ready or Failed)
+        ///
+        ////////////////////////////////////////////////////////////
+        Status wait() const;
+
+    private:
+
+        friend class AssetLoader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the future from a request state
+        ///
+        /// \param state State of the request
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Future(priv::AssetLoaderState* state);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        priv::AssetLoaderState* m_state; ///< Shared state of the request
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the loader
+    ///
+    /// Worker threads are only started when there are requests
+    /// to process, and they stop as soon as the queue is empty.
+    ///
+    /// \param workerCount Maximum number of images decoded in parallel
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AssetLoader(unsigned int workerCount = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the images being decoded; the requests that
+    /// were not processed yet are marked as Failed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AssetLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request an image to be loaded from a file
+    ///
+    /// The image is modified by a worker thread: it must not be
+    /// used or destroyed until the request is complete.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param image    Image to load the file into
+    ///
+    /// \return Future to check the completion of the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Future loadImage(const std::string& filename, Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a texture to be loaded from a file
+    ///
+    /// The image is decoded by a worker thread, and uploaded to
+    /// the texture by upload() (or by the worker thread if
+    /// background uploads are enabled). The texture must not be
+    /// used or destroyed until the request is complete.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param texture  Texture to load the file into
+    ///
+    /// \return Future to check the completion of the request
+    ///
+    /// \see upload, setBackgroundUpload
+    ///
+    ////////////////////////////////////////////////////////////
+    Future loadTexture(const std::string& filename, Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the decoded textures, within a time budget
+    ///
+    /// This function must be called regularly (typically once
+    /// per frame) from a thread with an active OpenGL context.
+    /// Large textures are uploaded in several slices, so that
+    /// a single call doesn't exceed the budget by much. At least
+    /// one slice is uploaded per call if any is waiting.
+    ///
+    /// \param budget Maximum time to spend uploading
+    ///
+    /// \return Number of texture requests completed by this call
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int upload(Time budget = milliseconds(2));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable uploads by the worker threads
+    ///
+    /// When enabled, each worker thread activates its own OpenGL
+    /// context, shared with all the other contexts, and uploads
+    /// the textures itself right after decoding them; calling
+    /// upload() is then unnecessary. This removes all the work
+    /// from the rendering thread, but some drivers serialize the
+    /// contexts, so it is not always faster.
+    /// This is disabled by default.
+    ///
+    /// \param enabled True to upload from the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBackgroundUpload(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of requests not complete yet
+    ///
+    /// \return Number of pending requests
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPendingCount() const;
+
+private:
+
+    struct Request;
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a new request and start a worker if needed
+    ///
+    /// \param request Request to queue
+    ///
+    /// \return Future to check the completion of the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Future push(Request* request);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void work(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Complete a request and destroy it
+    ///
+    /// \param request Request to complete
+    /// \param success True if the asset was loaded successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    void complete(Request* request, bool success);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable Mutex         m_mutex;            ///< Mutex protecting the queues and the workers state
+    std::vector<Worker*>  m_workers;          ///< Worker threads decoding the images
+    unsigned int          m_workerCount;      ///< Maximum number of worker threads
+    std::deque<Request*>  m_decodeQueue;      ///< Requests waiting to be decoded
+    std::deque<Request*>  m_uploadQueue;      ///< Textures waiting to be uploaded
+    unsigned int          m_pendingCount;     ///< Number of requests not complete yet
+    bool                  m_backgroundUpload; ///< Do the worker threads upload the textures?
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASSETLOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AssetLoader
+/// \ingroup graphics
+///
+/// sf::AssetLoader loads images and textures without blocking
+/// the calling thread, which is useful to load a whole level
+/// while keeping the application responsive.
+///
+/// Image files are decoded by a pool of worker threads. Each
+/// load request returns an sf::AssetLoader::Future, which
+/// tells when the asset is ready to be used.
+///
+/// Textures also need to be uploaded to the graphics card,
+/// which requires an OpenGL context. By default this is done
+/// by the upload() function, which must be called regularly
+/// by the rendering thread and only spends the given time
+/// budget, so that the frame rate stays smooth while the
+/// textures are loading. Alternatively, the uploads can be
+/// done by the worker threads themselves, see
+/// setBackgroundUpload.
+///
+/// The images and textures given to the loader are owned by
+/// the caller, and must stay alive and untouched until their
+/// request is complete.
+///
+/// Usage example:
+/// \code
+/// sf::AssetLoader loader;
+///
+/// std::vector<sf::Texture> textures(filenames.size());
+/// std::vector<sf::AssetLoader::Future> futures;
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     futures.push_back(loader.loadTexture(filenames[i], textures[i]));
+///
+/// while (window.isOpen())
+/// {
+///     // ... handle events ...
+///
+///     // Spend at most 2 milliseconds per frame uploading textures
+///     loader.upload(sf::milliseconds(2));
+///
+///     if (loader.getPendingCount() == 0)
+///     {
+///         // Everything is loaded, draw the level
+///     }
+///     else
+///     {
+///         // Draw a loading screen
+///     }
+///
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
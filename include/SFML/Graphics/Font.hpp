@@ -60,6 +60,18 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Holds statistics about the glyph texture of a character size
+    ///
+    ////////////////////////////////////////////////////////////
+    struct PageStats
+    {
+        Vector2u     textureSize; ///< Current size of the texture
+        std::size_t  glyphCount;  ///< Number of glyphs loaded
+        Uint64       usedArea;    ///< Number of pixels of the texture allocated to glyphs
+        unsigned int resizeCount; ///< Number of times the texture had to grow
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -175,6 +187,29 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded the first time that they are
+    /// requested, which can cause a noticeable hitch when a lot
+    /// of new characters are displayed at once (localized text,
+    /// for example). This function loads all the glyphs of
+    /// \a characters which are not loaded yet, and uploads them
+    /// to the texture in a single operation.
+    ///
+    /// It is typically called during loading screens. It can be
+    /// called from a loading thread, as long as the font is not
+    /// used by any other thread at the same time.
+    ///
+    /// \param characters    Characters to load
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold versions or the regular ones?
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, unsigned int characterSize, bool bold) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -249,6 +284,26 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the texture of a certain size
+    ///
+    /// These statistics let you check how well the glyphs are
+    /// packed into the texture (usedArea compared to the total
+    /// texture area), and how often the texture had to grow,
+    /// which is an expensive operation. If you notice frequent
+    /// resizes, you may want to request the glyphs that you
+    /// need earlier, e.g. during loading.
+    ///
+    /// If no glyph of the requested size has been loaded yet,
+    /// all the statistics are zero.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Statistics about the texture of the requested size
+    ///
+    ////////////////////////////////////////////////////////////
+    PageStats getPageStats(unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -262,22 +317,26 @@ public:
 private:
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Structure defining a segment of the skyline of a page
+    ///
+    /// The skyline is the top edge of the area occupied by the glyphs
+    /// of a page; each node is a horizontal segment of this edge.
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    struct SkylineNode
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+        SkylineNode(unsigned int nodeLeft, unsigned int nodeTop, unsigned int nodeWidth) : left(nodeLeft), top(nodeTop), width(nodeWidth) {}
 
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        unsigned int left;  ///< X position of the segment into the texture
+        unsigned int top;   ///< Y position of the segment (first free line below the glyphs)
+        unsigned int width; ///< Width of the segment
     };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint32, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    typedef std::map<Uint32, Glyph> GlyphTable;   ///< Table mapping a codepoint to its glyph
+    typedef std::map<Uint64, float> KerningTable; ///< Table mapping a pair of codepoints to their kerning
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -287,10 +346,14 @@ private:
     {
         Page();
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        GlyphTable               glyphs;      ///< Table mapping code points to their corresponding glyph
+        Texture                  texture;     ///< Texture containing the pixels of the glyphs
+        std::vector<SkylineNode> skyline;     ///< Segments of the skyline, sorted from left to right
+        Uint64                   usedArea;    ///< Number of pixels allocated to glyphs
+        unsigned int             resizeCount; ///< Number of times the texture was resized
+        std::vector<Glyph>       latinGlyphs; ///< Copy of the Latin-1 glyphs, directly indexed by code point (regular, then bold)
+        std::vector<bool>        latinLoaded; ///< Tells which entries of latinGlyphs are loaded
+        KerningTable             kerning;     ///< Cache of the kerning between pairs of characters
     };
 
     ////////////////////////////////////////////////////////////
@@ -311,6 +374,21 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph into the pixel buffer
+    ///
+    /// The texture rect of the returned glyph only holds the size
+    /// of the bitmap, its position is left to the caller.
+    ///
+    /// \param codePoint     Unicode code point of the character to rasterize
+    /// \param characterSize Reference character size
+    /// \param bold          Rasterize the bold version or the regular one?
+    ///
+    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph rasterizeGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
@@ -318,11 +396,22 @@ private:
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
     ///
-    /// \return Found rectangle within the texture
+    /// \return Found rectangle within the texture, or a 2x2 rectangle
+    ///         if the texture can't grow enough to hold it
     ///
     ////////////////////////////////////////////////////////////
     IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Double the size of the texture of a page
+    ///
+    /// \param page Page of glyphs to resize
+    ///
+    /// \return True on success, false if the maximum texture size was reached
+    ///
+    ////////////////////////////////////////////////////////////
+    bool resizePage(Page& page) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
     ///
@@ -333,10 +422,24 @@ private:
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of a character in the font face
+    ///
+    /// The indices are cached, to avoid querying FreeType
+    /// every time.
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Index of the character, 0 if the font doesn't have it
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharIndex(Uint32 codePoint) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, Page> PageTable;        ///< Table mapping a character size to its page (texture)
+    typedef std::map<Uint32, unsigned int> CharIndexTable; ///< Table mapping a codepoint to its index in the font face
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -348,6 +451,7 @@ private:
     Info                       m_info;        ///< Information about the font
     mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
     mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable CharIndexTable     m_charIndices; ///< Cache of the indices of the characters in the font face
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
     #endif
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_INSTANCE_HPP
+#define SFML_INSTANCE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Per-instance attributes used by instanced drawing
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Instance
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The transform is the identity and the color is white.
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform
+    ///
+    /// The instance color is white.
+    ///
+    /// \param theTransform Instance transform
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance(const Transform& theTransform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform and color
+    ///
+    /// \param theTransform Instance transform
+    /// \param theColor     Instance color
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance(const Transform& theTransform, const Color& theColor);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Transform transform; ///< Transform applied to the vertices of the instance
+    Color     color;     ///< Color modulated with the color of the vertices of the instance
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Instance
+/// \ingroup graphics
+///
+/// sf::Instance holds the attributes that differ between the
+/// copies of a same geometry drawn with
+/// sf::RenderTarget::drawInstanced: a transform, combined with
+/// the transform of the render states, and a color, modulated
+/// with the color of each vertex.
+///
+/// The transform of an sf::Transformable (sf::Sprite, sf::Shape,
+/// sf::Text, or your own classes) can be used directly.
+///
+/// Example:
+/// \code
+/// // a 4x4 white quad
+/// sf::Vertex quad[] =
+/// {
+///     sf::Vertex(sf::Vector2f(0, 0)),
+///     sf::Vertex(sf::Vector2f(0, 4)),
+///     sf::Vertex(sf::Vector2f(4, 4)),
+///     sf::Vertex(sf::Vector2f(4, 0))
+/// };
+///
+/// // one instance per particle
+/// std::vector<sf::Instance> instances(particles.size());
+/// for (std::size_t i = 0; i < particles.size(); ++i)
+///     instances[i] = sf::Instance(particles[i].getTransform(), particles[i].color);
+///
+/// // draw all of them at once
+/// window.drawInstanced(quad, 4, sf::Quads, &instances[0], instances.size());
+/// \endcode
+///
+/// \see sf::RenderTarget::drawInstanced
+///
+////////////////////////////////////////////////////////////
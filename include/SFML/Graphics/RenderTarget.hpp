@@ -38,11 +38,14 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class Instance;
+class VertexBuffer;
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -247,6 +250,119 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many copies of the same primitives with a single call
+    ///
+    /// The primitives defined by \a vertices are drawn once for
+    /// every element of \a instances. Each copy is transformed by
+    /// the combination of \a states.transform and the transform
+    /// of its instance, and the color of its vertices is modulated
+    /// by the color of its instance.
+    ///
+    /// This is much cheaper than drawing every copy separately:
+    /// the instances are expanded to a single list of primitives
+    /// and sent to the graphics card with one draw call (or added
+    /// to the pending batch, see setBatchingEnabled).
+    ///
+    /// Note that this function does not use hardware instancing:
+    /// the fixed-function pipeline used by SFML cannot read
+    /// per-instance attributes, so the expansion is always done
+    /// on the CPU. The cost of a call therefore still grows with
+    /// vertexCount * instanceCount, only the per-draw overhead
+    /// (state changes and driver calls) is saved.
+    ///
+    /// \param vertices      Pointer to the vertices of one instance
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives to draw
+    /// \param instances     Pointer to the per-instance attributes
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                       const Instance* instances, std::size_t instanceCount,
+                       const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a range of a vertex buffer
+    ///
+    /// The range is clamped to the size of the vertex buffer.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+              std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draw calls that use
+    /// the same texture, blend mode, shader and primitive type are
+    /// not sent to the graphics card immediately: their vertices
+    /// are pre-transformed and accumulated into a single buffer,
+    /// which is rendered with one draw call when the render states
+    /// change, when the view changes, when the target is displayed
+    /// or captured, when a render texture is deactivated, or when
+    /// flush() is called explicitly.
+    ///
+    /// Strips and fans are converted to the equivalent lists of
+    /// primitives, so that they can be batched too.
+    ///
+    /// While batching is enabled, textures and shaders used for
+    /// drawing must stay alive and unmodified until the pending
+    /// geometry is flushed. If you update a texture or change the
+    /// parameters of a shader between two draw calls, call flush()
+    /// first.
+    ///
+    /// Batching is disabled by default. Disabling it flushes any
+    /// pending geometry.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the geometry accumulated by the batching mode
+    ///
+    /// This function is called automatically whenever the batch
+    /// cannot be extended anymore, so you only need to call it
+    /// when you're about to modify a resource that the pending
+    /// geometry refers to, or to mix SFML drawing with your own
+    /// OpenGL calls without using pushGLStates/popGLStates.
+    /// It does nothing if batching is disabled or if nothing
+    /// is pending.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -340,8 +456,53 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the target for rendering
+    ///
+    /// Several targets may render with the same OpenGL context,
+    /// so the base class keeps track of the target which is
+    /// active in each context. Activating the target which is
+    /// already active costs nothing; when a target takes over
+    /// a context from another one, its OpenGL states are set
+    /// again before the next draw.
+    ///
+    /// \param active True to make the target active, false to deactivate it
+    ///
+    /// \return True if the function succeeded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setTargetActive(bool active);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send primitives to the graphics card, bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(const Vertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the view, blend mode, texture and shader before a draw call
+    ///
+    /// \param states Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the states that must not leak out of a draw call
+    ///
+    /// \param states Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupDraw(const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -384,8 +545,9 @@ private:
     /// \brief Activate the target for rendering
     ///
     /// This function must be implemented by derived classes to make
-    /// their OpenGL context current; it is called by the base class
-    /// everytime it's going to use OpenGL calls.
+    /// their OpenGL context current and to bind their frame buffer;
+    /// it is called by the base class when the target is not the
+    /// active one in the current context.
     ///
     /// \param active True to make the target active, false to deactivate it
     ///
@@ -410,12 +572,29 @@ private:
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending geometry of the batching mode
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enabled;   ///< Is batching enabled?
+        std::vector<Vertex> vertices;  ///< Pre-transformed vertices storage (only grows)
+        std::size_t         count;     ///< Number of vertices pending in the storage
+        PrimitiveType       type;      ///< Primitive type of the pending vertices
+        RenderStates        states;    ///< Render states of the pending vertices (identity transform)
+        Uint64              textureId; ///< Cache identifier of the pending texture
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                m_defaultView;      ///< Default view
+    View                m_view;             ///< Current view
+    StatesCache         m_cache;            ///< Render states cache
+    Batch               m_batch;            ///< Draw calls batch
+    std::vector<Vertex> m_instanceVertices; ///< Storage for the expanded instances (only grows)
+    Uint64              m_id;               ///< Unique number that identifies the target in the contexts it uses
 };
 
 } // namespace sf
@@ -134,12 +134,14 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Activate of deactivate the render-texture for rendering
     ///
-    /// This function makes the render-texture's context current for
+    /// This function makes the render-texture the target of
     /// future OpenGL rendering operations (so you shouldn't care
     /// about it if you're not doing direct OpenGL stuff).
-    /// Only one context can be current in a thread, so if you
+    /// When frame buffer objects are supported, the render-texture
+    /// doesn't own an OpenGL context: it binds its frame buffer in
+    /// the context which is active on the calling thread, so if you
     /// want to draw OpenGL geometry to another render target
-    /// (like a RenderWindow) don't forget to activate it again.
+    /// (like a RenderWindow), deactivate the render-texture first.
     ///
     /// \param active True to activate, false to deactivate
     ///
@@ -156,6 +158,16 @@ public:
     /// function is mandatory at the end of rendering. Not calling
     /// it may leave the texture in an undefined state.
     ///
+    /// When frame buffer objects are supported, the frame buffer
+    /// of the current context is restored afterwards, so that
+    /// OpenGL calls made in the same context don't render to
+    /// the texture anymore.
+    ///
+    /// This function doesn't flush the OpenGL commands: if the
+    /// texture is used by a context of another thread, make sure
+    /// that the rendering is finished before (with glFinish for
+    /// example).
+    ///
     ////////////////////////////////////////////////////////////
     void display();
 
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycles render textures of the same size and format
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the render textures of the pool, including
+    /// the ones which were not released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render texture from the pool
+    ///
+    /// A released render texture with the same size and format is
+    /// reused if there is one, otherwise a new one is created.
+    /// Recycled render textures are returned with their default
+    /// view, smoothing and repeating disabled, and with the
+    /// contents that they had when they were released.
+    ///
+    /// \param width       Width of the render texture
+    /// \param height      Height of the render texture
+    /// \param depthBuffer Does the render texture need a depth buffer?
+    ///
+    /// \return Pointer to the render texture, or NULL if it couldn't be created
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, bool depthBuffer = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a render texture back to the pool
+    ///
+    /// The render texture is not destroyed, it is kept until
+    /// another request with the same size and format is made,
+    /// or until clear is called. It must not be used anymore
+    /// after this call.
+    ///
+    /// \param texture Render texture to release, previously returned by acquire
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the released render textures
+    ///
+    /// The render textures currently acquired are not affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of released render textures waiting to be reused
+    ///
+    /// \return Number of available render textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAvailableCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render texture owned by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        RenderTexture* texture;     ///< The render texture
+        bool           depthBuffer; ///< Was it created with a depth buffer?
+    };
+
+    typedef std::vector<Entry> EntryArray;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EntryArray m_available; ///< Released render textures, waiting to be reused
+    EntryArray m_acquired;  ///< Render textures currently in use
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a render texture allocates a texture and a frame
+/// buffer on the graphics card, which is too slow to be done
+/// every frame. sf::RenderTexturePool keeps the render textures
+/// that are not needed anymore, and gives them back when a
+/// render texture with the same size and format is requested.
+/// This is useful for temporary targets whose number changes
+/// over time, such as the intermediate steps of a chain of
+/// post-processing effects.
+///
+/// The pool owns all the render textures that it returns: they
+/// are destroyed with the pool. It is not thread-safe, it must
+/// be used from one thread at a time.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// // Apply a blur effect through a temporary render texture
+/// sf::RenderTexture* temporary = pool.acquire(800, 600);
+/// temporary->clear();
+/// temporary->draw(scene, &horizontalBlur);
+/// temporary->display();
+/// window.draw(sf::Sprite(temporary->getTexture()), &verticalBlur);
+///
+/// // The next acquire(800, 600) will reuse it
+/// pool.release(temporary);
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
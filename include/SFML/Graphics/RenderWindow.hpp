@@ -123,6 +123,10 @@ public:
     /// You can also draw things directly to a texture with the
     /// sf::RenderTexture class.
     ///
+    /// The geometry that may still be pending in the draw calls
+    /// batch (see RenderTarget::setBatchingEnabled) is rendered
+    /// first, so that it appears in the captured image.
+    ///
     /// \return Image containing the captured contents
     ///
     ////////////////////////////////////////////////////////////
@@ -149,6 +153,17 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window is displayed
+    ///
+    /// This function renders the geometry that may still be
+    /// pending in the draw calls batch, so that it is part of
+    /// the displayed frame even when display() is called through
+    /// a reference to the sf::Window base class.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -37,6 +37,7 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -79,6 +80,55 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pre-resolved location of a shader parameter
+    ///
+    /// A handle avoids looking the parameter up by name every
+    /// time it is changed. It is only valid for the shader which
+    /// returned it, until this shader is loaded again.
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API UniformHandle
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Constructs an invalid handle, which is ignored by
+        /// all the functions that take a handle.
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a parameter
+        ///
+        /// \return True if the parameter was found in the shader
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const;
+
+    private:
+
+        friend class Shader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle from a parameter location
+        ///
+        /// \param location Location of the parameter, or -1
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit UniformHandle(int location);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        int m_location; ///< Location of the parameter in the program
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -456,6 +506,189 @@ public:
     ////////////////////////////////////////////////////////////
     void setParameter(const std::string& name, CurrentTextureType);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a parameter of the shader
+    ///
+    /// Looking the parameter up once and then changing it through
+    /// its handle is faster than passing its name every time.
+    /// The handle stays valid until the shader is loaded again.
+    ///
+    /// \code
+    /// sf::Shader::UniformHandle offset = shader.getUniformHandle("offset");
+    /// ...
+    /// shader.setParameter(offset, 2.f);
+    /// \endcode
+    ///
+    /// \param name Name of the parameter in the shader
+    ///
+    /// \return Handle to the parameter, invalid if it doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a float parameter of the shader
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param x      Value to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 2-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param x      First component of the value to assign
+    /// \param y      Second component of the value to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 3-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param x      First component of the value to assign
+    /// \param y      Second component of the value to assign
+    /// \param z      Third component of the value to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, float x, float y, float z);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 4-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param x      First component of the value to assign
+    /// \param y      Second component of the value to assign
+    /// \param z      Third component of the value to assign
+    /// \param w      Fourth component of the value to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, float x, float y, float z, float w);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 2-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param vector Vector to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, const Vector2f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 3-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param vector Vector to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, const Vector3f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a color parameter of the shader
+    ///
+    /// The components of the color are normalized to the
+    /// range [0 .. 1], see setParameter(const std::string&, const Color&).
+    ///
+    /// \param handle Handle of the parameter in the shader
+    /// \param color  Color to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a matrix parameter of the shader
+    ///
+    /// \param handle    Handle of the parameter in the shader
+    /// \param transform Transform to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a texture parameter of the shader
+    ///
+    /// \a texture must remain alive as long as the shader uses
+    /// it, no copy is made internally.
+    ///
+    /// \param handle  Handle of the texture in the shader
+    /// \param texture Texture to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a texture parameter to the texture of the object being drawn
+    ///
+    /// \param handle Handle of the texture in the shader
+    ///
+    /// \see getUniformHandle, setParameter(const std::string&, CurrentTextureType)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(UniformHandle handle, CurrentTextureType);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change an array of float or vector parameters
+    ///
+    /// \a components is the size of each element of the array:
+    /// 1 for a float array, 2 for a vec2 array, 3 for vec3 and
+    /// 4 for vec4. The whole array is sent to the program in a
+    /// single call.
+    ///
+    /// Example:
+    /// \code
+    /// uniform vec2 points[8]; // this is the variable in the shader
+    /// \endcode
+    /// \code
+    /// float points[16] = {...};
+    /// shader.setParameterArray(shader.getUniformHandle("points"), points, 8, 2);
+    /// \endcode
+    ///
+    /// \param handle     Handle of the array in the shader
+    /// \param values     Pointer to the components of the elements
+    /// \param length     Number of elements in the array
+    /// \param components Number of components of each element (1 to 4)
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameterArray(UniformHandle handle, const float* values, std::size_t length, unsigned int components = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change an array of matrix parameters
+    ///
+    /// The corresponding parameter in the shader must be an
+    /// array of 4x4 matrices (mat4 GLSL type).
+    ///
+    /// \param handle     Handle of the array in the shader
+    /// \param transforms Pointer to the transforms to assign
+    /// \param length     Number of transforms in the array
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameterArray(UniformHandle handle, const Transform* transforms, std::size_t length);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the shader.
     ///
@@ -531,6 +764,28 @@ private:
     ////////////////////////////////////////////////////////////
     void bindTextures() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the value of a parameter until the shader is bound
+    ///
+    /// A value stored for the same location replaces the
+    /// previous one.
+    ///
+    /// \param location   Location of the parameter
+    /// \param values     Components of the value
+    /// \param components Number of components per element (1 to 4, or 16 for a matrix)
+    /// \param length     Number of elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeUniform(int location, const float* values, unsigned int components, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the stored parameter values to the program
+    ///
+    /// The program must be in use when this function is called.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyUniforms() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader parameter
     ///
@@ -544,16 +799,27 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
+    struct UniformValue
+    {
+        int          location;   ///< Location of the parameter
+        unsigned int components; ///< Number of components per element
+        std::size_t  length;     ///< Number of elements
+        std::size_t  offset;     ///< Index of the first component in the value buffer
+    };
+
     typedef std::map<int, const Texture*> TextureTable;
     typedef std::map<std::string, int> ParamTable;
+    typedef std::vector<UniformValue> UniformTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    ParamTable   m_params;         ///< Parameters location cache
+    unsigned int               m_shaderProgram;  ///< OpenGL identifier for the program
+    int                        m_currentTexture; ///< Location of the current texture in the shader
+    TextureTable               m_textures;       ///< Texture variables in the shader, mapped to their location
+    ParamTable                 m_params;         ///< Parameters location cache
+    mutable UniformTable       m_uniforms;       ///< Parameter values waiting to be sent to the program
+    mutable std::vector<float> m_uniformValues;  ///< Components of the waiting parameter values
 };
 
 } // namespace sf
@@ -607,6 +873,21 @@ private:
 /// given texture variable to the current texture of the
 /// object being drawn (which cannot be known in advance).
 ///
+/// The new values are not sent to the graphics card right
+/// away: they are stored, and applied all at once the next
+/// time the shader is bound for drawing. If a variable is
+/// changed often, look it up once with getUniformHandle and
+/// pass the handle instead of the name. Arrays of floats,
+/// vectors and matrices can be set in a single call with
+/// setParameterArray:
+/// \code
+/// sf::Shader::UniformHandle offset = shader.getUniformHandle("offset");
+/// sf::Shader::UniformHandle bones = shader.getUniformHandle("bones");
+/// ...
+/// shader.setParameter(offset, 2.f);
+/// shader.setParameterArray(bones, transforms, 32); // transforms is an array of sf::Transform
+/// \endcode
+///
 /// To apply a shader to a drawable, you must pass it as an
 /// additional parameter to the Draw function:
 /// \code
@@ -101,6 +101,10 @@ public:
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// If the new string only appends characters to the current
+    /// one, only the new characters are laid out, which makes
+    /// growing texts (consoles, chat logs) cheap to update.
+    ///
     /// \param string New string
     ///
     /// \see getString
@@ -298,17 +302,37 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the layout after the last character processed
+    ///
+    /// It allows to lay out only the new characters when the
+    /// string is extended, instead of the whole string.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Layout
+    {
+        Layout() : length(0), vertexCount(0), lastChar(0) {}
+
+        std::size_t length;      ///< Number of characters already laid out
+        std::size_t vertexCount; ///< Number of vertices of these characters (lines of the last row excluded)
+        Vector2f    position;    ///< Position of the next character
+        Vector2f    min;         ///< Minimum coordinates of the characters laid out so far
+        Vector2f    max;         ///< Maximum coordinates of the characters laid out so far
+        Uint32      lastChar;    ///< Last character laid out, for kerning
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;             ///< String to display
-    const Font*         m_font;               ///< Font used to display the string
-    unsigned int        m_characterSize;      ///< Base size of characters, in pixels
-    Uint32              m_style;              ///< Text style (see Style enum)
-    Color               m_color;              ///< Text color
-    mutable VertexArray m_vertices;           ///< Vertex array containing the text's geometry
-    mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    String                      m_string;             ///< String to display
+    const Font*                 m_font;               ///< Font used to display the string
+    unsigned int                m_characterSize;      ///< Base size of characters, in pixels
+    Uint32                      m_style;              ///< Text style (see Style enum)
+    Color                       m_color;              ///< Text color
+    mutable std::vector<Vertex> m_vertices;           ///< Vertices containing the text's geometry (triangles)
+    mutable FloatRect           m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
+    mutable Layout              m_layout;             ///< State of the layout, to lay out appended characters only
+    mutable bool                m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
 };
 
 } // namespace sf
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DATAGRAMBATCH_HPP
+#define SFML_DATAGRAMBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Set of datagrams sent or received at once by a UDP socket
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API DatagramBatch
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch
+    ///
+    /// The memory for all the datagrams is allocated once here,
+    /// and reused every time the batch is filled. If you know
+    /// that your datagrams are small, choose a small maximum
+    /// size: this saves a lot of memory. Bigger datagrams
+    /// are dropped when they are received.
+    ///
+    /// \param capacity        Maximum number of datagrams in the batch
+    /// \param maxDatagramSize Maximum size of a single datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DatagramBatch(std::size_t capacity = 64, std::size_t maxDatagramSize = UdpSocket::MaxDatagramSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of datagrams in the batch
+    ///
+    /// \return Capacity of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum size of a single datagram
+    ///
+    /// \return Maximum size of a datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxDatagramSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of datagrams in the batch
+    ///
+    /// \return Number of datagrams
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the datagrams from the batch
+    ///
+    /// The memory of the batch is kept for the next datagrams.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a datagram to send to the batch
+    ///
+    /// The data is copied into the batch. This function fails if
+    /// the batch is full or if the data is bigger than the
+    /// maximum datagram size.
+    ///
+    /// \param data          Pointer to the sequence of bytes to send
+    /// \param size          Number of bytes to send
+    /// \param remoteAddress Address of the receiver
+    /// \param remotePort    Port of the receiver to send the data to
+    ///
+    /// \return True if the datagram was added, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool append(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a packet to send to the batch
+    ///
+    /// \param packet        Packet to send
+    /// \param remoteAddress Address of the receiver
+    /// \param remotePort    Port of the receiver to send the data to
+    ///
+    /// \return True if the packet was added, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool append(Packet& packet, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the data of a datagram
+    ///
+    /// \param index Index of the datagram, in range [0, getCount())
+    ///
+    /// \return Pointer to the bytes of the datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a datagram
+    ///
+    /// \param index Index of the datagram, in range [0, getCount())
+    ///
+    /// \return Size of the datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDataSize(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the peer of a datagram
+    ///
+    /// For received datagrams, this is the sender; for datagrams
+    /// to send, this is the receiver.
+    ///
+    /// \param index Index of the datagram, in range [0, getCount())
+    ///
+    /// \return Address of the peer
+    ///
+    ////////////////////////////////////////////////////////////
+    const IpAddress& getRemoteAddress(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of the peer of a datagram
+    ///
+    /// \param index Index of the datagram, in range [0, getCount())
+    ///
+    /// \return Port of the peer
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getRemotePort(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a datagram as a packet, without copying it
+    ///
+    /// The returned packet reads directly the memory of the batch:
+    /// it is valid only until the batch is cleared or filled
+    /// again. Unlike UdpSocket::receive, this function doesn't
+    /// call Packet::onReceive, so it can't be used with packets
+    /// that transform their data.
+    ///
+    /// \param index Index of the datagram, in range [0, getCount())
+    ///
+    /// \return Packet containing the datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& getPacket(std::size_t index);
+
+private:
+
+    friend class UdpSocket;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory reserved for a datagram
+    ///
+    /// \param index Index of the datagram, in range [0, getCapacity())
+    ///
+    /// \return Pointer to the memory of the datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    char* getBuffer(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a datagram of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Datagram
+    {
+        std::size_t    size;    ///< Number of bytes of the datagram
+        IpAddress      address; ///< Address of the peer
+        unsigned short port;    ///< Port of the peer
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t           m_capacity;        ///< Maximum number of datagrams
+    std::size_t           m_maxDatagramSize; ///< Maximum size of a datagram
+    std::vector<char>     m_buffer;          ///< Memory of all the datagrams
+    std::vector<Datagram> m_datagrams;       ///< Datagrams currently in the batch
+    std::vector<Packet>   m_packets;         ///< Packets reading the datagrams (see getPacket)
+};
+
+} // namespace sf
+
+
+#endif // SFML_DATAGRAMBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DatagramBatch
+/// \ingroup network
+///
+/// sf::DatagramBatch stores many datagrams in a single block
+/// of memory, so that a UDP socket can send or receive all of
+/// them at once with UdpSocket::sendBatch and
+/// UdpSocket::receiveBatch. On systems which support it, a
+/// whole batch is transfered with a single system call, which
+/// makes a big difference when an application exchanges
+/// a lot of small datagrams.
+///
+/// A batch should be created once and reused: its memory is
+/// allocated when it is constructed, receiving datagrams into
+/// it or adding datagrams to send never allocates memory.
+///
+/// Usage example:
+/// \code
+/// sf::UdpSocket socket;
+/// socket.bind(55002);
+///
+/// sf::DatagramBatch batch(64, 1024);
+/// while (socket.receiveBatch(batch) == sf::Socket::Done)
+/// {
+///     for (std::size_t i = 0; i < batch.getCount(); ++i)
+///     {
+///         sf::Packet& packet = batch.getPacket(i);
+///         float x, y;
+///         if (packet >> x >> y)
+///             std::cout << batch.getRemoteAddress(i).toString() << " moved to " << x << ", " << y << std::endl;
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include <SFML/System/Time.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -308,27 +309,29 @@ public:
         friend class Http;
 
         ////////////////////////////////////////////////////////////
-        /// \brief Construct the header from a response string
+        /// \brief Read the status line of the response
         ///
         /// This function is used by Http to build the response
-        /// of a request.
+        /// of a request, directly from its receive buffer.
         ///
-        /// \param data Content of the response to parse
+        /// \param begin Pointer to the first character of the line
+        /// \param end   Pointer past the last character of the line
+        ///
+        /// \return True if the line is a valid status line
         ///
         ////////////////////////////////////////////////////////////
-        void parse(const std::string& data);
-
+        bool parseStatusLine(const char* begin, const char* end);
 
         ////////////////////////////////////////////////////////////
-        /// \brief Read values passed in the answer header
+        /// \brief Read a header field of the response
         ///
-        /// This function is used by Http to extract values passed
-        /// in the response.
+        /// Lines which are not valid fields are ignored.
         ///
-        /// \param in String stream containing the header values
+        /// \param begin Pointer to the first character of the line
+        /// \param end   Pointer past the last character of the line
         ///
         ////////////////////////////////////////////////////////////
-        void parseFields(std::istream &in);
+        void parseField(const char* begin, const char* end);
 
         ////////////////////////////////////////////////////////////
         // Types
@@ -345,6 +348,40 @@ public:
         std::string  m_body;         ///< Body of the response
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Interface of the objects receiving a response body progressively
+    ///
+    /// Passing a body handler to sendRequest allows to process
+    /// big downloads as they arrive (writing them to a file, for
+    /// example) instead of storing them entirely in memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API BodyHandler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~BodyHandler() {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called every time a part of the body is received
+        ///
+        /// The status and the header fields of the response are
+        /// already available when this function is called.
+        ///
+        /// \param response Response being received (without its body)
+        /// \param data     Pointer to the received bytes
+        /// \param size     Number of bytes
+        ///
+        /// \return True to continue, false to abort the download
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onBodyData(const Response& response, const char* data, std::size_t size) = 0;
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -404,15 +441,158 @@ public:
     ////////////////////////////////////////////////////////////
     Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and stream the response body to a handler
+    ///
+    /// This function works like the other overload, except that
+    /// the body of the response is passed to \a handler as it
+    /// is received, and is not stored in the returned response.
+    ///
+    /// \param request Request to send
+    /// \param handler Object receiving the body of the response
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, without its body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, BodyHandler& handler, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several HTTP requests and return the server's responses
+    ///
+    /// When keep-alive is enabled, the requests are pipelined:
+    /// they are all sent at once, and the responses are read
+    /// afterwards, which saves a network round trip per request.
+    /// If the server closes the connection before answering all
+    /// the requests, the remaining ones are sent again on a new
+    /// connection, so only pipeline requests that can safely be
+    /// repeated (like GET requests).
+    ///
+    /// \param requests Requests to send
+    /// \param timeout  Maximum time to wait
+    ///
+    /// \return Server's responses, in the same order as the requests
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Response> sendRequests(const std::vector<Request>& requests, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable persistent connections
+    ///
+    /// When keep-alive is enabled, the connection to the host is
+    /// kept open after a request, and reused by the next ones as
+    /// long as the server allows it. This saves the time needed
+    /// to connect for every request. Keep-alive is disabled by
+    /// default.
+    ///
+    /// \param keepAlive True to enable keep-alive, false to disable it
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepAlive(bool keepAlive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the persistent connection to the host
+    ///
+    /// This function does nothing if there's no open connection.
+    ///
+    /// \see setKeepAlive
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect();
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Result of the reception of a response
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ReceiveResult
+    {
+        KeepConnection,  ///< The response was received, the connection can be reused
+        CloseConnection, ///< The response was received (or failed), the connection must be closed
+        NoResponse       ///< The connection was closed before anything was received
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request
+    ///
+    /// \param request Request to complete
+    ///
+    ////////////////////////////////////////////////////////////
+    void completeRequest(Request& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send requests and receive their responses
+    ///
+    /// \param requests  Requests to send
+    /// \param responses Responses to fill (must have the same size as \a requests)
+    /// \param handler   Object receiving the bodies, or NULL to store them in the responses
+    /// \param timeout   Maximum time to wait for the connection
+    ///
+    ////////////////////////////////////////////////////////////
+    void exchange(const std::vector<Request>& requests, std::vector<Response>& responses, BodyHandler* handler, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a response from the server
+    ///
+    /// \param response Response to fill
+    /// \param request  Request which the response answers
+    /// \param handler  Object receiving the body, or NULL to store it in the response
+    ///
+    /// \return What to do with the connection
+    ///
+    ////////////////////////////////////////////////////////////
+    ReceiveResult receiveResponse(Response& response, const Request& request, BodyHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the given number of bytes of a response body
+    ///
+    /// \param response Response to fill
+    /// \param handler  Object receiving the body, or NULL to store it in the response
+    /// \param length   Number of bytes to receive
+    ///
+    /// \return True on success, false if the connection failed or the handler aborted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveBody(Response& response, BodyHandler* handler, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the next line from the receive buffer
+    ///
+    /// The line is valid until the buffer is filled again.
+    ///
+    /// \param begin Index of the first character of the line in the buffer
+    /// \param end   Index past the last character of the line (line ending excluded)
+    ///
+    /// \return True if a line was extracted, false if the connection failed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveLine(std::size_t& begin, std::size_t& end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive more data into the receive buffer
+    ///
+    /// The data already consumed is discarded, so this function
+    /// invalidates the indices in the buffer.
+    ///
+    /// \return True if data was received, false if the connection failed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool fillBuffer();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket      m_connection; ///< Connection to the host
-    IpAddress      m_host;       ///< Web host address
-    std::string    m_hostName;   ///< Web host name
-    unsigned short m_port;       ///< Port used for connection with host
+    TcpSocket         m_connection; ///< Connection to the host
+    IpAddress         m_host;       ///< Web host address
+    std::string       m_hostName;   ///< Web host name
+    unsigned short    m_port;       ///< Port used for connection with host
+    bool              m_keepAlive;  ///< Are persistent connections enabled?
+    bool              m_connected;  ///< Is the connection to the host open?
+    std::vector<char> m_buffer;     ///< Data received from the host and not processed yet
+    std::size_t       m_bufferPos;  ///< Position of the first unprocessed byte in the buffer
 };
 
 } // namespace sf
@@ -453,6 +633,13 @@ private:
 /// sf::Http::Request and return the corresponding sf::Http::Response
 /// from the server.
 ///
+/// By default, a new connection is opened for every request.
+/// When many requests are sent to the same host, enable
+/// keep-alive with setKeepAlive so that the connection is
+/// reused, and send batches of requests with sendRequests to
+/// pipeline them. Big downloads can be processed progressively
+/// by passing a sf::Http::BodyHandler to sendRequest.
+///
 /// Usage example:
 /// \code
 /// // Create a new HTTP client
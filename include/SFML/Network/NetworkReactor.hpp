@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_NETWORKREACTOR_HPP
+#define SFML_NETWORKREACTOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+class Socket;
+class TcpListener;
+class TcpSocket;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Event loop that serves many sockets and notifies
+///        a handler of what happens on them
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API NetworkReactor : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 TimerId; ///< Identifier of a timer
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Interface of the objects notified by a reactor
+    ///
+    /// All the functions have an empty default implementation,
+    /// you only need to override the ones that you need.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Handler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Handler() {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a listener accepted a new connection
+        ///
+        /// The new socket is owned by the reactor, and already added
+        /// to it: you can send packets to it immediately, or remove
+        /// it to refuse the connection.
+        ///
+        /// This function is called by the thread which serves the
+        /// listener, before the socket is watched: the other callbacks
+        /// of the socket are called after it returns, by the thread
+        /// which serves the socket.
+        ///
+        /// \param reactor  Reactor which accepted the connection
+        /// \param listener Listener which received the connection
+        /// \param socket   New socket connected to the client
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onAccept(NetworkReactor& reactor, TcpListener& listener, TcpSocket& socket);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a packet was received on a TCP socket
+        ///
+        /// \param reactor Reactor which received the packet
+        /// \param socket  Socket which received the packet
+        /// \param packet  Received packet
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onPacket(NetworkReactor& reactor, TcpSocket& socket, Packet& packet);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a packet was received on a UDP socket
+        ///
+        /// \param reactor       Reactor which received the packet
+        /// \param socket        Socket which received the packet
+        /// \param packet        Received packet
+        /// \param remoteAddress Address of the peer that sent the packet
+        /// \param remotePort    Port of the peer that sent the packet
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onDatagram(NetworkReactor& reactor, UdpSocket& socket, Packet& packet, const IpAddress& remoteAddress, unsigned short remotePort);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when all the packets queued for a TCP socket were sent
+        ///
+        /// This is the right place to queue more data when sending
+        /// a big amount of it, without filling the memory.
+        ///
+        /// \param reactor Reactor which sent the packets
+        /// \param socket  Socket which sent the packets
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onWritable(NetworkReactor& reactor, TcpSocket& socket);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a TCP socket was disconnected by its peer, or failed
+        ///
+        /// The socket is then automatically removed from the reactor.
+        ///
+        /// \param reactor Reactor which owned the socket
+        /// \param socket  Socket which was disconnected
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onDisconnect(NetworkReactor& reactor, TcpSocket& socket);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a socket is removed from the reactor
+        ///
+        /// After this call, the reactor doesn't use the socket
+        /// anymore: if it was added by you, you can destroy it;
+        /// if it was created by the reactor (accepted connection),
+        /// it is destroyed right after this call.
+        ///
+        /// \param reactor Reactor which owned the socket
+        /// \param socket  Socket which was removed
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onRemove(NetworkReactor& reactor, Socket& socket);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a timer expires
+        ///
+        /// \param reactor Reactor which owns the timer
+        /// \param timer   Identifier of the timer
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onTimer(NetworkReactor& reactor, TimerId timer);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the reactor
+    ///
+    /// With more than one thread, the sockets are distributed
+    /// among the threads, and each thread serves its own sockets;
+    /// the callbacks of a socket are always called by the same
+    /// thread (except onAccept, see its description), but the
+    /// callbacks of different sockets may be called concurrently.
+    /// Timers are always run by the thread which calls run().
+    ///
+    /// \param handler     Object to notify of the network events
+    /// \param threadCount Number of threads serving the sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit NetworkReactor(Handler& handler, unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The sockets created by the reactor are destroyed, the
+    /// other ones are left untouched. The reactor must not be
+    /// running anymore when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~NetworkReactor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a listener to the reactor
+    ///
+    /// The listener must be listening already. New connections
+    /// are accepted automatically, and notified with onAccept.
+    ///
+    /// \param listener Listener to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(TcpListener& listener);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a connected TCP socket to the reactor
+    ///
+    /// \param socket Socket to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a bound UDP socket to the reactor
+    ///
+    /// \param socket Socket to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(UdpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a socket from the reactor
+    ///
+    /// While the reactor is running, the removal is processed
+    /// by the thread that serves the socket, and onRemove tells
+    /// when it is done; the socket must stay alive until then.
+    ///
+    /// \param socket Socket to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a packet to send to a TCP socket
+    ///
+    /// The packet is copied, and sent as soon as the socket can
+    /// accept more data; packets are sent in the order they are
+    /// queued. This function does nothing if the socket is not
+    /// in the reactor.
+    ///
+    /// \param socket Socket to send the packet to
+    /// \param packet Packet to send
+    ///
+    ////////////////////////////////////////////////////////////
+    void send(TcpSocket& socket, const Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a timer
+    ///
+    /// \param delay    Time until the timer first expires
+    /// \param interval Time between two expirations after the first one,
+    ///                 or Time::Zero for a timer which expires once
+    ///
+    /// \return Identifier of the new timer
+    ///
+    /// \see stopTimer
+    ///
+    ////////////////////////////////////////////////////////////
+    TimerId startTimer(Time delay, Time interval = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a timer
+    ///
+    /// \param timer Identifier of the timer to stop
+    ///
+    /// \see startTimer
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopTimer(TimerId timer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the event loop
+    ///
+    /// This function blocks until stop is called. With more
+    /// than one thread, it launches the other threads and
+    /// waits for them before returning.
+    ///
+    /// \see stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make run return as soon as possible
+    ///
+    /// This function can be called from any thread, including
+    /// from the callbacks. If the reactor is not running, the
+    /// next call to run returns immediately.
+    ///
+    /// \see run
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+private:
+
+    struct Entry;
+    struct Shard;
+    friend struct Shard;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new socket in one of the threads
+    ///
+    /// \param entry Description of the socket to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void addEntry(Entry* entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new socket without watching it yet
+    ///
+    /// \param entry Description of the socket to add
+    ///
+    /// \return Thread which serves the socket, or NULL if the
+    ///         socket was already in the reactor
+    ///
+    ////////////////////////////////////////////////////////////
+    Shard* registerEntry(Entry* entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the thread which serves a socket
+    ///
+    /// \param socket Socket to look up
+    ///
+    /// \return Thread in charge of the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    Shard* getShard(const Socket& socket) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the event loop must stop
+    ///
+    /// \return True if stop was called since the previous run returned
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStopping() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the expired timers
+    ///
+    /// \return Time until the next timer expires, or Time::Zero if there's none
+    ///
+    ////////////////////////////////////////////////////////////
+    Time runTimers();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::multimap<Int64, TimerId> TimerQueue;  ///< Pending timer expirations, sorted by date (in microseconds)
+    typedef std::map<TimerId, Int64> TimerTable;       ///< Active timers with their interval (in microseconds)
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Handler&            m_handler;    ///< Object notified of the network events
+    std::vector<Shard*> m_shards;     ///< Threads serving the sockets
+    mutable Mutex       m_mutex;      ///< Mutex protecting the members below
+    bool                m_running;    ///< Is the event loop running?
+    bool                m_stopping;   ///< Must the event loop stop?
+    Clock               m_clock;      ///< Clock measuring the timers
+    TimerQueue          m_timerQueue; ///< Pending timer expirations
+    TimerTable          m_timers;     ///< Active timers
+    TimerId             m_nextTimer;  ///< Identifier of the next timer
+};
+
+} // namespace sf
+
+
+#endif // SFML_NETWORKREACTOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NetworkReactor
+/// \ingroup network
+///
+/// sf::NetworkReactor implements the usual event loop of
+/// network servers: it waits for events on many sockets at
+/// once, accepts new connections, receives packets, sends
+/// queued packets as fast as the peers can receive them, and
+/// runs timers. What happens is notified to a user-defined
+/// sf::NetworkReactor::Handler.
+///
+/// All the sockets are switched to non-blocking mode when they
+/// are added, and must not be used directly for receiving
+/// anymore. Packets sent with NetworkReactor::send are queued
+/// and never block; UDP sockets can still be used directly for
+/// sending datagrams.
+///
+/// To serve a lot of clients, the reactor can distribute its
+/// sockets among several threads. While the reactor is
+/// running, the add, remove, send, startTimer, stopTimer and
+/// stop functions can be called from any thread, including
+/// from the callbacks; the handler must then be ready to be
+/// called concurrently for different sockets.
+///
+/// Usage example:
+/// \code
+/// class Echo : public sf::NetworkReactor::Handler
+/// {
+///     virtual void onPacket(sf::NetworkReactor& reactor, sf::TcpSocket& socket, sf::Packet& packet)
+///     {
+///         reactor.send(socket, packet);
+///     }
+/// };
+///
+/// sf::TcpListener listener;
+/// listener.listen(55001);
+///
+/// Echo echo;
+/// sf::NetworkReactor reactor(echo, 4);
+/// reactor.add(listener);
+/// reactor.run();
+/// \endcode
+///
+/// \see sf::SocketSelector, sf::TcpSocket, sf::UdpSocket
+///
+////////////////////////////////////////////////////////////
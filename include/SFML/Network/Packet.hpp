@@ -59,12 +59,36 @@ public:
     ////////////////////////////////////////////////////////////
     Packet();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The copy always owns its data, even if the source packet
+    /// reads external data (like the packets of a sf::DatagramBatch).
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(const Packet& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
     ////////////////////////////////////////////////////////////
     virtual ~Packet();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// Like the copy constructor, the assigned packet always
+    /// owns its data.
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& operator =(const Packet& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Append data to the end of the packet
     ///
@@ -76,10 +100,26 @@ public:
     ////////////////////////////////////////////////////////////
     void append(const void* data, std::size_t sizeInBytes);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for the data of the packet
+    ///
+    /// If you know how big a packet will be, reserving its memory
+    /// before writing to it avoids reallocations.
+    ///
+    /// \param sizeInBytes Total number of bytes to reserve
+    ///
+    /// \see clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t sizeInBytes);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clear the packet
     ///
-    /// After calling Clear, the packet is empty.
+    /// After calling Clear, the packet is empty. Its memory is
+    /// kept though, so a packet which is cleared and filled again
+    /// (for every snapshot of a game state, for example) stops
+    /// allocating memory once it is big enough.
     ///
     /// \see append
     ///
@@ -212,8 +252,73 @@ public:
     Packet& operator <<(const std::wstring& data);
     Packet& operator <<(const String&       data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of values into the packet
+    ///
+    /// This is much faster than writing the elements one by one.
+    /// Only characters, fixed-size integers (sf::Int8 to sf::Uint64)
+    /// and floating point numbers are supported; using any other
+    /// type is a compile error. Integers are converted to network
+    /// byte order, like with operator <<, and floating point numbers
+    /// are copied as they are. The number of elements is not written.
+    ///
+    /// \param data  Pointer to the elements to write
+    /// \param count Number of elements to write
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readArray
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Packet& writeArray(const T* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of values from the packet
+    ///
+    /// This is the counterpart of writeArray. If the packet
+    /// doesn't contain \a count elements, nothing is read and
+    /// the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the elements to fill
+    /// \param count Number of elements to read
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeArray
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Packet& readArray(T* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// Overloads of writeVarint to write compact integers
+    ///
+    /// The integers are written with a variable number of bytes
+    /// (LEB128 encoding): small values take less space, from one
+    /// byte for values below 128. Signed integers are first
+    /// zigzag-encoded, so that small negative values are small
+    /// too. They must be read back with readVarint and the same
+    /// type.
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeVarint(Int32  data);
+    Packet& writeVarint(Uint32 data);
+    Packet& writeVarint(Int64  data);
+    Packet& writeVarint(Uint64 data);
+
+    ////////////////////////////////////////////////////////////
+    /// Overloads of readVarint to read compact integers
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarint(Int32&  data);
+    Packet& readVarint(Uint32& data);
+    Packet& readVarint(Int64&  data);
+    Packet& readVarint(Uint64& data);
+
 protected:
 
+    friend class DatagramBatch;
     friend class TcpSocket;
     friend class UdpSocket;
 
@@ -277,15 +382,82 @@ private:
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the data at the reading position
+    ///
+    /// \return Pointer to the next byte to read
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* getReadPointer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the packet read external data without copying it
+    ///
+    /// The packet contents are replaced by the external data,
+    /// which must stay alive and unchanged as long as the packet
+    /// uses it. Appending data to the packet makes it copy the
+    /// external data to its own storage first.
+    ///
+    /// \param data Pointer to the external data
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setView(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the external data to the packet's own storage
+    ///
+    /// This function does nothing if the packet doesn't read
+    /// external data.
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an array of elements to the packet
+    ///
+    /// \param data        Pointer to the elements
+    /// \param count       Number of elements
+    /// \param elementSize Size of an element, in bytes
+    /// \param swapBytes   Convert the elements to network byte order?
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendArray(const void* data, std::size_t count, std::size_t elementSize, bool swapBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract an array of elements from the packet
+    ///
+    /// \param data        Pointer to the elements to fill
+    /// \param count       Number of elements
+    /// \param elementSize Size of an element, in bytes
+    /// \param swapBytes   Convert the elements from network byte order?
+    ///
+    ////////////////////////////////////////////////////////////
+    void extractArray(void* data, std::size_t count, std::size_t elementSize, bool swapBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract a variable-length integer from the packet
+    ///
+    /// \param maxBits Maximum number of significant bits of the integer
+    ///
+    /// \return Decoded integer (0 if the packet is invalid)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 extractVarint(unsigned int maxBits);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    std::size_t       m_sendPos; ///< Current send position in the packet (for handling partial sends)
-    bool              m_isValid; ///< Reading state of the packet
+    std::vector<char> m_data;     ///< Data stored in the packet
+    const char*       m_view;     ///< External data read instead of m_data (see setView), or NULL
+    std::size_t       m_viewSize; ///< Number of bytes of external data
+    std::size_t       m_readPos;  ///< Current reading position in the packet
+    std::size_t       m_sendPos;  ///< Current send position in the packet (for handling partial sends)
+    bool              m_isValid;  ///< Reading state of the packet
 };
 
+#include <SFML/Network/Packet.inl>
+
 } // namespace sf
 
 
@@ -350,6 +522,12 @@ private:
 /// \li floating point numbers (float, double)
 /// \li string types (char*, wchar_t*, std::string, std::wstring, sf::String)
 ///
+/// Arrays of values can be written and read at once with
+/// writeArray and readArray, which is much faster than with
+/// a loop; integers that are usually small (counters, indices,
+/// deltas) can be written in a compact form with writeVarint
+/// and read with readVarint.
+///
 /// Like standard streams, it is also possible to define your own
 /// overloads of operators >> and << in order to handle your
 /// custom types.
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+namespace priv
+{
+// Tell whether the elements of an array are converted to network byte order;
+// only multi-byte integers are, like with the operators << and >>.
+// The primary template is left undefined, so that arrays of any other type
+// (structures, pointers, ...) are rejected at compile time instead of being
+// copied as raw memory
+template <typename T>
+struct PacketArrayTraits;
+
+template <> struct PacketArrayTraits<char>   {enum {SwapBytes = false};};
+template <> struct PacketArrayTraits<Int8>   {enum {SwapBytes = false};};
+template <> struct PacketArrayTraits<Uint8>  {enum {SwapBytes = false};};
+template <> struct PacketArrayTraits<float>  {enum {SwapBytes = false};};
+template <> struct PacketArrayTraits<double> {enum {SwapBytes = false};};
+template <> struct PacketArrayTraits<Int16>  {enum {SwapBytes = true};};
+template <> struct PacketArrayTraits<Uint16> {enum {SwapBytes = true};};
+template <> struct PacketArrayTraits<Int32>  {enum {SwapBytes = true};};
+template <> struct PacketArrayTraits<Uint32> {enum {SwapBytes = true};};
+template <> struct PacketArrayTraits<Int64>  {enum {SwapBytes = true};};
+template <> struct PacketArrayTraits<Uint64> {enum {SwapBytes = true};};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Packet& Packet::writeArray(const T* data, std::size_t count)
+{
+    appendArray(data, count, sizeof(T), priv::PacketArrayTraits<T>::SwapBytes);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Packet& Packet::readArray(T* data, std::size_t count)
+{
+    extractArray(data, count, sizeof(T), priv::PacketArrayTraits<T>::SwapBytes);
+    return *this;
+}
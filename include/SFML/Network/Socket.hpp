@@ -166,6 +166,32 @@ protected:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether received data is waiting in an internal buffer
+    ///
+    /// Data which was already read from the system, but not yet
+    /// consumed by the user, is invisible to the system's readiness
+    /// notifications. Socket selectors use this function so that
+    /// they still report such sockets as ready.
+    ///
+    /// \return True if buffered data is available, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasBufferedData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the selectors watching the socket that data was buffered
+    ///
+    /// Derived classes which buffer received data must call this
+    /// function when new data is stored in their buffer, so that
+    /// the selectors don't have to ask every socket whether it
+    /// has buffered data.
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    ////////////////////////////////////////////////////////////
+    void onDataBuffered();
+
 private:
 
     friend class SocketSelector;
@@ -173,9 +199,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;       ///< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;     ///< Socket descriptor
-    bool         m_isBlocking; ///< Current blocking mode of the socket
+    Type                         m_type;       ///< Type of the socket (TCP or UDP)
+    SocketHandle                 m_socket;     ///< Socket descriptor
+    bool                         m_isBlocking; ///< Current blocking mode of the socket
+    std::vector<SocketSelector*> m_selectors;  ///< Selectors watching the socket
 };
 
 } // namespace sf
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +45,12 @@ class SFML_NETWORK_API SocketSelector
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Iterator over the sockets that are ready
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::vector<Socket*>::const_iterator ReadyIterator;
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -108,8 +115,9 @@ public:
     /// \brief Wait until one or more sockets are ready to receive
     ///
     /// This function returns as soon as at least one socket has
-    /// some data available to be received. To know which sockets are
-    /// ready, use the isReady function.
+    /// some data available to be received, or at least one socket
+    /// watched with setSendMonitoring can send data. To know which
+    /// sockets are ready, use the isReady and isReadyToSend functions.
     /// If you use a timeout and no socket is ready before the timeout
     /// is over, the function returns false.
     ///
@@ -141,6 +149,73 @@ public:
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether to wait until a socket can send data
+    ///
+    /// By default, the selector only waits for incoming data.
+    /// When this is enabled for a socket, wait also returns when
+    /// the socket can accept more data to send, which allows to
+    /// send in non-blocking mode without retrying blindly. Since
+    /// a connected socket is almost always ready to send, it
+    /// should be enabled only while data is waiting to be sent.
+    ///
+    /// This function does nothing if the socket is not in the selector.
+    ///
+    /// \param socket  Socket to watch
+    /// \param enabled True to wait until the socket is ready to send
+    ///
+    /// \see isReadyToSend
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSendMonitoring(Socket& socket, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Test a socket to know if it is ready to send data
+    ///
+    /// This function must be used after a call to wait, and only
+    /// reports the sockets for which send monitoring is enabled.
+    ///
+    /// \param socket Socket to test
+    ///
+    /// \return True if the socket is ready to send, false otherwise
+    ///
+    /// \see setSendMonitoring, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReadyToSend(Socket& socket) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an iterator to the first socket that is ready
+    ///
+    /// Iterating over the ready sockets is much faster than
+    /// calling isReady on every socket, when the selector
+    /// contains a lot of sockets. Since the selector doesn't
+    /// know the actual type of the sockets, you have to cast
+    /// them back to the type that you added.
+    ///
+    /// The sockets which are only ready to send are included;
+    /// use isReady and isReadyToSend to tell them apart.
+    ///
+    /// The iterators are valid until the next call to wait,
+    /// remove or clear.
+    ///
+    /// \return Iterator to the first socket that is ready
+    ///
+    /// \see endReady
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadyIterator beginReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an iterator past the last socket that is ready
+    ///
+    /// \return Iterator past the last socket that is ready
+    ///
+    /// \see beginReady
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadyIterator endReady() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -153,8 +228,29 @@ public:
 
 private:
 
+    friend class Socket;
+
     struct SocketSelectorImpl;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Register all the sockets of the implementation
+    ///        as watched by this selector
+    ///
+    ////////////////////////////////////////////////////////////
+    void registerSockets();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remember that a socket has buffered data
+    ///
+    /// This function is called by the socket itself, so that
+    /// wait doesn't have to check every socket.
+    /// It may be called from any thread receiving on the socket.
+    ///
+    /// \param socket Socket which has buffered data
+    ///
+    ////////////////////////////////////////////////////////////
+    void addBufferedSocket(Socket& socket);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -191,6 +287,17 @@ private:
 /// socket container, you must store them outside and make sure
 /// that they are alive as long as they are used in the selector.
 ///
+/// On Linux, the selector is based on epoll and can handle
+/// thousands of sockets efficiently; on other Unix systems it
+/// uses poll, and on Windows it is limited to FD_SETSIZE sockets.
+///
+/// A selector is not thread-safe: add, remove, clear, wait and
+/// the isReady functions must all be called from the same thread.
+/// The sockets may however be used to receive on other threads
+/// while the selector waits; the data that they buffer is then
+/// reported at the next call to wait. Adding or removing a socket
+/// while another thread receives on it is not supported.
+///
 /// Using a selector is simple:
 /// \li populate the selector with all the sockets that you want to observe
 /// \li make it wait until there is data available on any of the sockets
@@ -258,6 +365,18 @@ private:
 /// }
 /// \endcode
 ///
+/// With a lot of clients, it is more efficient to iterate over
+/// the sockets that are ready rather than testing all of them:
+/// \code
+/// for (sf::SocketSelector::ReadyIterator it = selector.beginReady(); it != selector.endReady(); ++it)
+/// {
+///     if (*it == &listener)
+///         ...
+///     else
+///         receiveFrom(static_cast<sf::TcpSocket&>(**it));
+/// }
+/// \endcode
+///
 /// \see sf::Socket
 ///
 ////////////////////////////////////////////////////////////
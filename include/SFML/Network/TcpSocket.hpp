@@ -191,6 +191,54 @@ public:
     ////////////////////////////////////////////////////////////
     Status send(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// This function gives the same result as calling send for
+    /// each packet, but the packets are grouped so that they
+    /// are sent with as few system calls as possible.
+    ///
+    /// To be able to handle partial sends over non-blocking
+    /// sockets, use the sendBatch(Packet*, std::size_t, std::size_t&)
+    /// overload instead.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Array of packets to send
+    /// \param count   Number of packets in the array
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendBatch(Packet* packets, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// This function gives the same result as calling send for
+    /// each packet, but the packets are grouped so that they
+    /// are sent with as few system calls as possible.
+    ///
+    /// In non-blocking mode, if this function returns sf::Socket::Partial,
+    /// \a sent contains the number of packets that were completely sent;
+    /// you \em must then retry sending the remaining packets, starting
+    /// with packets[sent] unmodified, before sending anything else in
+    /// order to guarantee that the packets arrive at the remote peer
+    /// uncorrupted.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Array of packets to send
+    /// \param count   Number of packets in the array
+    /// \param sent    The number of packets completely sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendBatch(Packet* packets, std::size_t count, std::size_t& sent);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive a formatted packet of data from the remote peer
     ///
@@ -207,6 +255,45 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the packets to receive
+    ///
+    /// The size of each packet is sent by the remote peer, and
+    /// enough memory is allocated to receive it. To protect
+    /// against malicious or broken peers, you can limit it:
+    /// if a bigger packet is announced, receive(Packet&) fails
+    /// with sf::Socket::Error and, since the data stream can't
+    /// be trusted anymore, the socket is disconnected.
+    ///
+    /// The default value, 0, means no limit.
+    ///
+    /// \param size Maximum size of a packet, in bytes (0 for no limit)
+    ///
+    /// \see getMaxPacketSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxPacketSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum size of the packets to receive
+    ///
+    /// \return Maximum size of a packet, in bytes (0 for no limit)
+    ///
+    /// \see setMaxPacketSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxPacketSize() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether received data is waiting in the read-ahead buffer
+    ///
+    /// \return True if buffered data is available, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasBufferedData() const;
+
 private:
 
     friend class TcpListener;
@@ -221,13 +308,26 @@ private:
 
         Uint32            Size;         ///< Data of packet size
         std::size_t       SizeReceived; ///< Number of size bytes received so far
+        std::size_t       DataReceived; ///< Number of data bytes received so far
         std::vector<char> Data;         ///< Data of the packet
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive as many bytes as possible into the read-ahead buffer
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status fillReceiveBuffer();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    PendingPacket     m_pendingPacket; ///< Temporary data of the packet currently being received
+    std::vector<char> m_receiveBuffer; ///< Read-ahead buffer, filled by large reads and consumed packet by packet
+    std::size_t       m_receiveBegin;  ///< Position of the first unread byte in the read-ahead buffer
+    std::size_t       m_receiveEnd;    ///< Position after the last unread byte in the read-ahead buffer
+    std::size_t       m_maxPacketSize; ///< Maximum size of a received packet (0 means no limit)
 };
 
 } // namespace sf
@@ -270,6 +370,13 @@ private:
 /// but if you want to explicitly close the connection while
 /// the socket instance is still alive, you can call disconnect.
 ///
+/// Large reads are stored in a read-ahead buffer and then
+/// consumed by the following calls to receive. A socket must
+/// therefore not receive from several threads at the same time;
+/// receiving on one thread while a sf::SocketSelector waits on
+/// another is fine, as long as the socket is not added to or
+/// removed from the selector meanwhile.
+///
 /// Usage example:
 /// \code
 /// // ----- The client -----
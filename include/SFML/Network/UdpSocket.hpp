@@ -35,6 +35,7 @@
 
 namespace sf
 {
+class DatagramBatch;
 class IpAddress;
 class Packet;
 
@@ -91,6 +92,24 @@ public:
     ////////////////////////////////////////////////////////////
     Status bind(unsigned short port);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the socket to a specific port and address
+    ///
+    /// This function behaves like bind(unsigned short), except
+    /// that the socket only receives the datagrams sent to
+    /// \a address. For example, binding to IpAddress::LocalHost
+    /// makes the socket unreachable from other computers.
+    ///
+    /// \param port    Port to bind the socket to
+    /// \param address Address of the local interface to bind to
+    ///
+    /// \return Status code
+    ///
+    /// \see unbind, getLocalPort
+    ///
+    ////////////////////////////////////////////////////////////
+    Status bind(unsigned short port, const IpAddress& address);
+
     ////////////////////////////////////////////////////////////
     /// \brief Unbind the socket from the local port to which it is bound
     ///
@@ -180,6 +199,60 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send all the datagrams of a batch
+    ///
+    /// The datagrams are sent in order, with as few system calls
+    /// as possible. This function stops at the first datagram
+    /// which can't be sent; in non-blocking mode, use the other
+    /// overload to know how many datagrams were sent.
+    ///
+    /// \param batch Datagrams to send
+    ///
+    /// \return Status code
+    ///
+    /// \see receiveBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendBatch(const DatagramBatch& batch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send all the datagrams of a batch
+    ///
+    /// If only some of the datagrams could be sent (because the
+    /// socket is in non-blocking mode and its buffer is full),
+    /// this function returns sf::Socket::Partial and \a sent
+    /// contains the number of datagrams that were sent.
+    ///
+    /// \param batch Datagrams to send
+    /// \param sent  The number of datagrams sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see receiveBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendBatch(const DatagramBatch& batch, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive as many datagrams as possible in a batch
+    ///
+    /// The previous contents of the batch are replaced. In
+    /// blocking mode, this function waits for one datagram,
+    /// then it adds to the batch the other ones which are
+    /// already available, until the batch is full; so the
+    /// batch is never empty when the function returns
+    /// sf::Socket::Done.
+    ///
+    /// \param batch Batch to fill with the received datagrams
+    ///
+    /// \return Status code
+    ///
+    /// \see sendBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveBatch(DatagramBatch& batch);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -278,6 +351,10 @@ private:
 /// socket.send(message.c_str(), message.size() + 1, sender, port);
 /// \endcode
 ///
-/// \see sf::Socket, sf::TcpSocket, sf::Packet
+/// When a lot of datagrams are exchanged, they can also be
+/// sent and received in batches (see sf::DatagramBatch), which
+/// requires much less system calls than one datagram at a time.
+///
+/// \see sf::Socket, sf::TcpSocket, sf::Packet, sf::DatagramBatch
 ///
 ////////////////////////////////////////////////////////////
@@ -31,14 +31,22 @@
 
 #include <SFML/Config.hpp>
 #include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FastMutex.hpp>
 #include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/FramePacer.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ScopedLock.hpp>
+#include <SFML/System/SharedLock.hpp>
+#include <SFML/System/SharedMutex.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/SpinLock.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/ThreadLocal.hpp>
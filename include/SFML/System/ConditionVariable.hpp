@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_CONDITIONVARIABLE_HPP
+#define SFML_CONDITIONVARIABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ConditionImpl;
+}
+
+class FastMutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Lets threads sleep until another thread wakes them up
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ConditionVariable : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition variable is notified
+    ///
+    /// The mutex must be locked by the calling thread. It is
+    /// released while the thread waits, and locked again
+    /// before this function returns. The thread may wake up
+    /// without being notified, so the condition that it waits
+    /// for must be checked again in a loop.
+    ///
+    /// \param mutex Mutex protecting the condition
+    ///
+    /// \see notifyOne, notifyAll
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(FastMutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition variable is notified,
+    ///        with a timeout
+    ///
+    /// This function behaves like wait(FastMutex&), except that
+    /// it returns after \a timeout if nothing wakes the thread
+    /// up before.
+    ///
+    /// \param mutex   Mutex protecting the condition
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(FastMutex& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one of the threads waiting on the condition variable
+    ///
+    /// \see notifyAll, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the threads waiting on the condition variable
+    ///
+    /// \see notifyOne, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ConditionImpl* m_conditionImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ConditionVariable
+/// \ingroup system
+///
+/// A condition variable lets a thread wait efficiently until
+/// a condition, protected by a sf::FastMutex, becomes true:
+/// the thread sleeps in wait() until another thread changes
+/// the condition and notifies the condition variable.
+///
+/// Usage example:
+/// \code
+/// sf::FastMutex mutex;
+/// sf::ConditionVariable condition;
+/// std::queue<Job> jobs;
+///
+/// void worker()
+/// {
+///     sf::ScopedLock<sf::FastMutex> lock(mutex);
+///
+///     // Always wait in a loop, the thread may wake up spuriously
+///     while (jobs.empty())
+///         condition.wait(mutex);
+///
+///     Job job = jobs.front();
+///     jobs.pop();
+///     ...
+/// }
+///
+/// void addJob(const Job& job)
+/// {
+///     sf::ScopedLock<sf::FastMutex> lock(mutex);
+///     jobs.push(job);
+///     condition.notifyOne();
+/// }
+/// \endcode
+///
+/// \see sf::FastMutex
+///
+////////////////////////////////////////////////////////////
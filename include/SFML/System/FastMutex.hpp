@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FASTMUTEX_HPP
+#define SFML_FASTMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class MutexImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Non-recursive mutex, cheaper than sf::Mutex
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FastMutex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FastMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FastMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex
+    ///
+    /// If the mutex is already locked in another thread,
+    /// this call will block the execution until the mutex
+    /// is released. The mutex must not be already locked
+    /// by the calling thread.
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    void lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+private:
+
+    friend class ConditionVariable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::MutexImpl* m_mutexImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_FASTMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FastMutex
+/// \ingroup system
+///
+/// sf::FastMutex is a mutex which can't be locked recursively:
+/// locking it twice in the same thread is an error which
+/// deadlocks the thread. In return, it doesn't need to keep
+/// track of its owner, which makes it cheaper to lock than
+/// sf::Mutex, especially when several threads compete for it.
+///
+/// It is the mutex to use for short critical sections, and the
+/// one that works with sf::ConditionVariable.
+///
+/// Usage example:
+/// \code
+/// sf::FastMutex mutex;
+/// std::vector<int> values;
+///
+/// void addValue(int value)
+/// {
+///     sf::ScopedLock<sf::FastMutex> lock(mutex);
+///     values.push_back(value);
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::SpinLock, sf::ScopedLock
+///
+////////////////////////////////////////////////////////////
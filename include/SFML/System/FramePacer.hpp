@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEPACER_HPP
+#define SFML_FRAMEPACER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Utility class that schedules frames at a fixed rate
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FramePacer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Timing statistics of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Stats
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Stats();
+
+        Time   cpuTime;         ///< Time spent between the start of the frame and the presentation
+        Time   presentTime;     ///< Time spent presenting the frame
+        Time   frameTime;       ///< Total duration of the frame, including the wait
+        Uint64 frameCount;      ///< Number of frames since the pacer was started
+        Uint64 missedDeadlines; ///< Number of frames which ended after their deadline
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The pacer starts without any frame time limit and
+    /// without fixed timestep.
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the minimum duration of a frame
+    ///
+    /// The deadlines of the frames are computed from the start
+    /// of the schedule rather than from the end of the previous
+    /// frame, so that oversleeping in one frame is compensated
+    /// in the next one.
+    ///
+    /// \param limit Minimum duration of a frame (use Time::Zero to disable the limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameTimeLimit(Time limit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the minimum duration of a frame
+    ///
+    /// \return Minimum duration of a frame, Time::Zero if there's no limit
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTimeLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the duration of the busy wait before a deadline
+    ///
+    /// The pacer sleeps until this amount of time before the
+    /// deadline, and spins for the rest, since the OS usually
+    /// can't wake a thread up at an exact time. A larger value
+    /// gives more accurate frame times, at the cost of burning
+    /// more CPU time. The default is 1 millisecond.
+    ///
+    /// \param threshold Duration of the busy wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSpinThreshold(Time threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the schedule
+    ///
+    /// The current frame starts now, and the statistics are reset.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the pacer that the frame is about to be presented
+    ///
+    /// The time elapsed since the start of the frame is
+    /// recorded as its CPU time. Calling this function is
+    /// optional; if it is not called, the presentation time
+    /// is included in the CPU time.
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginPresent();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the current frame
+    ///
+    /// This function waits until the deadline of the current
+    /// frame if a frame time limit is set, and starts the next
+    /// frame. If the deadline has already passed, it returns
+    /// immediately; if the frame is later than a whole frame,
+    /// the schedule restarts from now instead of trying to
+    /// catch up with a burst of short frames.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last frame
+    ///
+    /// \return Statistics of the last completed frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const Stats& getStats() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the fixed timestep of the update() function
+    ///
+    /// \param timestep Duration of an update step (use Time::Zero to disable fixed steps)
+    /// \param maxSteps Maximum number of steps run by a single call to update()
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFixedTimestep(Time timestep, unsigned int maxSteps = 8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the fixed steps of simulation which are due
+    ///
+    /// This function calls \a function once for each fixed
+    /// timestep elapsed since the previous call, passing it the
+    /// timestep. \a function can be any callable taking a
+    /// sf::Time, such as a free function or a functor. If
+    /// more than \a maxSteps steps are due (after a hitch, for
+    /// example), the remaining time is dropped so that the
+    /// simulation doesn't spiral out of control.
+    ///
+    /// If no fixed timestep is set, \a function is called once
+    /// with the time elapsed since the previous call.
+    ///
+    /// \param function Function to call for each step
+    ///
+    /// \return Number of steps run
+    ///
+    /// \see getInterpolation
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    unsigned int update(F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress towards the next fixed step
+    ///
+    /// This is the time accumulated since the last step run by
+    /// update(), as a fraction of the timestep. It can be used to
+    /// interpolate between the two last simulation states when
+    /// rendering.
+    ///
+    /// \return Interpolation factor, in range [0, 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    float getInterpolation() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the number of fixed steps to run
+    ///
+    /// \return Number of steps due since the previous call
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int accumulateSteps();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Clock        m_clock;          ///< Clock that the whole schedule is based on
+    Time         m_frameTimeLimit; ///< Minimum duration of a frame
+    Time         m_spinThreshold;  ///< Duration of the busy wait before a deadline
+    Time         m_frameStart;     ///< Start of the current frame
+    Time         m_presentStart;   ///< Start of the presentation of the current frame
+    Time         m_deadline;       ///< Deadline of the current frame
+    Stats        m_stats;          ///< Statistics of the last frame
+    Time         m_timestep;       ///< Duration of a fixed update step
+    unsigned int m_maxSteps;       ///< Maximum number of steps per update
+    Time         m_lastUpdate;     ///< Time of the previous update
+    Time         m_accumulator;    ///< Time not consumed by update steps yet
+};
+
+#include <SFML/System/FramePacer.inl>
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPACER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FramePacer
+/// \ingroup system
+///
+/// sf::FramePacer keeps frames at a regular rate. Unlike a
+/// plain call to sf::sleep, it schedules frames on absolute
+/// deadlines, so that an early or late wake-up doesn't
+/// accumulate into drift, and it spins during the last moments
+/// before a deadline to hide the coarse granularity of the OS
+/// scheduler.
+///
+/// sf::Window uses a frame pacer internally to implement
+/// setFramerateLimit, and exposes its statistics through
+/// getFrameStats. It can also be used directly in custom loops,
+/// to pace frames or to run a simulation with a fixed timestep.
+///
+/// Usage example:
+/// \code
+/// sf::FramePacer pacer;
+/// pacer.setFrameTimeLimit(sf::seconds(1.f / 144));
+/// pacer.setFixedTimestep(sf::seconds(1.f / 120));
+///
+/// while (running)
+/// {
+///     // Run the simulation steps which are due
+///     pacer.update(updateWorld);
+///
+///     // Render, interpolating between the two last states
+///     render(pacer.getInterpolation());
+///
+///     pacer.beginPresent();
+///     swapBuffers();
+///     pacer.endFrame();
+///
+///     if (pacer.getStats().cpuTime > sf::milliseconds(5))
+///         reduceQuality();
+/// }
+/// \endcode
+///
+/// \see sf::Clock, sf::Window::setFramerateLimit
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_MAPPEDFILEINPUTSTREAM_HPP
+#define SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+    class MappedFileImpl;
+}
+
+class FileInputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on a file
+///        mapped in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MappedFileInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expected way of accessing the file contents
+    ///
+    ////////////////////////////////////////////////////////////
+    enum AccessPattern
+    {
+        Normal,     ///< No particular pattern
+        Sequential, ///< The file is read from the beginning to the end, more read-ahead is useful
+        Random,     ///< The file is accessed at random positions, read-ahead is useless
+        WillNeed    ///< The whole file will be needed soon, start loading it now
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the stream from a file path
+    ///
+    /// The file is mapped in memory if the system allows it,
+    /// otherwise it is read with regular buffered file I/O.
+    ///
+    /// \param filename Name of the file to open
+    ///
+    /// \return True on success, false on error
+    ///
+    /// \see isMapped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the system how the file is going to be accessed
+    ///
+    /// This is only a hint, which allows the system to tune
+    /// the loading of the file contents in memory. It has no
+    /// effect if the file is not mapped, or if the system
+    /// doesn't support it.
+    ///
+    /// \param pattern Expected access pattern
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAccessPattern(AccessPattern pattern);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the file is mapped in memory
+    ///
+    /// \return True if the file is mapped, false if it is read with regular file I/O
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isMapped() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the whole contents of the file
+    ///
+    /// The pointer stays valid until the stream is destroyed
+    /// or another file is opened. Reading through this pointer
+    /// doesn't change the reading position of the stream.
+    ///
+    /// \return Pointer to the file contents, or NULL if the file is not mapped
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the current file, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::MappedFileImpl* m_impl;     ///< OS-specific implementation of the file mapping
+    FileInputStream*      m_fallback; ///< Regular file stream, used when the file can't be mapped
+    const char*           m_data;     ///< Address of the mapped file contents
+    Int64                 m_size;     ///< Size of the mapped file, in bytes
+    Int64                 m_offset;   ///< Current reading position
+};
+
+} // namespace sf
+
+
+#endif // SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MappedFileInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that
+/// reads from a file on disk, like sf::FileInputStream,
+/// but maps the file in memory instead of reading it
+/// through a file handle.
+///
+/// Reading from a mapped file is a plain memory copy, without
+/// any system call, which makes the many small reads done by
+/// file format decoders much faster. Loaders that can work
+/// directly on memory can even avoid the copy with getData().
+/// The system can be told how the file is going to be read
+/// with setAccessPattern, so that it loads the contents ahead
+/// of time.
+///
+/// If the file can't be mapped (empty file, unsupported file
+/// system or platform), the stream transparently falls back
+/// to regular buffered file I/O; in this case getData()
+/// returns NULL.
+///
+/// Usage example:
+/// \code
+/// void process(const void* data, std::size_t size);
+/// void process(sf::InputStream& stream);
+///
+/// sf::MappedFileInputStream stream;
+/// if (stream.open("some_file.dat"))
+/// {
+///     stream.setAccessPattern(sf::MappedFileInputStream::Sequential);
+///
+///     if (stream.getData())
+///         process(stream.getData(), static_cast<std::size_t>(stream.getSize()));
+///     else
+///         process(stream);
+/// }
+/// \endcode
+///
+/// \see InputStream, FileInputStream, MemoryInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SCOPEDLOCK_HPP
+#define SFML_SCOPEDLOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Automatic wrapper for locking and unlocking
+///        any kind of mutex
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class ScopedLock : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the lock with a target mutex
+    ///
+    /// The mutex passed to sf::ScopedLock is automatically locked.
+    ///
+    /// \param mutex Mutex to lock
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ScopedLock(T& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor of sf::ScopedLock automatically unlocks its mutex.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ScopedLock();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    T& m_mutex; ///< Mutex to lock / unlock
+};
+
+#include <SFML/System/ScopedLock.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SCOPEDLOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ScopedLock
+/// \ingroup system
+///
+/// sf::ScopedLock works like sf::Lock, for any class which has
+/// a lock() and an unlock() function: sf::FastMutex,
+/// sf::SpinLock, sf::SharedMutex (locked for writing) and
+/// sf::Mutex.
+///
+/// Usage example:
+/// \code
+/// sf::FastMutex mutex;
+///
+/// void function()
+/// {
+///     sf::ScopedLock<sf::FastMutex> lock(mutex); // mutex is now locked
+///
+///     functionThatMayThrowAnException(); // mutex is unlocked if this function throws
+///
+/// } // mutex is unlocked
+/// \endcode
+///
+/// \see sf::Lock, sf::SharedLock
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SHAREDLOCK_HPP
+#define SFML_SHAREDLOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class SharedMutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Automatic wrapper for locking and unlocking
+///        shared mutexes for reading
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API SharedLock : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the lock with a target mutex
+    ///
+    /// The mutex passed to sf::SharedLock is automatically
+    /// locked for reading.
+    ///
+    /// \param mutex Mutex to lock
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SharedLock(SharedMutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor of sf::SharedLock automatically unlocks its mutex.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SharedLock();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SharedMutex& m_mutex; ///< Mutex to lock / unlock
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAREDLOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SharedLock
+/// \ingroup system
+///
+/// sf::SharedLock is the equivalent of sf::Lock for reading
+/// the data protected by a sf::SharedMutex: it calls
+/// lockShared() in its constructor, and unlockShared() in
+/// its destructor. To lock a shared mutex for writing, use
+/// sf::ScopedLock<sf::SharedMutex>.
+///
+/// \see sf::SharedMutex, sf::ScopedLock
+///
+////////////////////////////////////////////////////////////
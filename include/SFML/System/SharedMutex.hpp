@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SHAREDMUTEX_HPP
+#define SFML_SHAREDMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Mutex which can be shared by several readers,
+///        or owned by a single writer
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API SharedMutex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for writing
+    ///
+    /// This call blocks until no other thread holds the mutex,
+    /// either for reading or for writing.
+    ///
+    /// \see unlock, lockShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex locked for writing
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for reading
+    ///
+    /// This call blocks while a thread holds the mutex for
+    /// writing, or waits for it. Any number of threads may
+    /// hold the mutex for reading at the same time.
+    ///
+    /// \see unlockShared, lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockShared();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex locked for reading
+    ///
+    /// \see lockShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockShared();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FastMutex         m_mutex;          ///< Mutex protecting the state of the lock
+    ConditionVariable m_readers;        ///< Readers waiting for the writers to finish
+    ConditionVariable m_writers;        ///< Writers waiting for the lock to be free
+    unsigned int      m_readerCount;    ///< Number of threads holding the lock for reading
+    unsigned int      m_waitingWriters; ///< Number of threads waiting to lock for writing
+    bool              m_writing;        ///< Does a thread hold the lock for writing?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAREDMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SharedMutex
+/// \ingroup system
+///
+/// sf::SharedMutex protects data which is read much more often
+/// than it is modified: threads which only read the data lock
+/// the mutex with lockShared(), and don't block each other,
+/// while a thread which modifies it locks the mutex with lock()
+/// and gets exclusive access.
+///
+/// Writers have priority: once a writer waits for the mutex, new
+/// readers wait until it is done, so that a steady flow of
+/// readers can't lock writers out forever.
+///
+/// Like sf::FastMutex, sf::SharedMutex is not recursive.
+///
+/// Usage example:
+/// \code
+/// sf::SharedMutex mutex;
+/// std::map<std::string, Resource> resources;
+///
+/// const Resource* find(const std::string& name)
+/// {
+///     sf::SharedLock lock(mutex); // other readers may run at the same time
+///     std::map<std::string, Resource>::const_iterator it = resources.find(name);
+///     return it != resources.end() ? &it->second : NULL;
+/// }
+///
+/// void add(const std::string& name, const Resource& resource)
+/// {
+///     sf::ScopedLock<sf::SharedMutex> lock(mutex); // exclusive access
+///     resources[name] = resource;
+/// }
+/// \endcode
+///
+/// \see sf::SharedLock, sf::ScopedLock
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPINLOCK_HPP
+#define SFML_SPINLOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Lock which busy-waits instead of sleeping
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API SpinLock : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The lock is created unlocked.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpinLock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the spin lock
+    ///
+    /// If the lock is already held by another thread, this call
+    /// spins until it is released, giving the CPU away from time
+    /// to time. The lock must not be already held by the calling
+    /// thread.
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    void lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the spin lock
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    volatile long m_locked; ///< Is the lock held? (1 = held, 0 = free)
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPINLOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpinLock
+/// \ingroup system
+///
+/// sf::SpinLock protects a critical section like a mutex, but
+/// a thread which finds it locked keeps the CPU and polls it
+/// instead of going to sleep. It doesn't involve the OS at all,
+/// which makes it the cheapest lock when the critical sections
+/// are only a few instructions long, such as updating a counter
+/// or swapping a pointer. For anything longer, or anything that
+/// may block, use sf::FastMutex: spinning threads waste the CPU
+/// time that the owner of the lock may need to finish its work.
+///
+/// Usage example:
+/// \code
+/// sf::SpinLock lock;
+/// sf::Uint64 nextId = 0;
+///
+/// sf::Uint64 generateId()
+/// {
+///     sf::ScopedLock<sf::SpinLock> scopedLock(lock);
+///     return nextId++;
+/// }
+/// \endcode
+///
+/// \see sf::FastMutex, sf::ScopedLock
+///
+////////////////////////////////////////////////////////////
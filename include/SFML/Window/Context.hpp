@@ -88,6 +88,20 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the context active on the current thread
+    ///
+    /// Each context, including the internal contexts of SFML,
+    /// gets a unique identifier which is never reused, even
+    /// after the context is destroyed. This is useful to keep
+    /// track of OpenGL objects that cannot be shared between
+    /// contexts, such as frame buffer objects.
+    ///
+    /// \return Identifier of the active context, or 0 if none is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -133,6 +133,7 @@ public:
     struct JoystickConnectEvent
     {
         unsigned int joystickId; ///< Index of the joystick (in range [0 .. Joystick::Count - 1])
+        Int64        timestamp;  ///< Time of the event, in microseconds (see Joystick::getTimestamp)
     };
 
     ////////////////////////////////////////////////////////////
@@ -144,6 +145,7 @@ public:
         unsigned int   joystickId; ///< Index of the joystick (in range [0 .. Joystick::Count - 1])
         Joystick::Axis axis;       ///< Axis on which the joystick moved
         float          position;   ///< New position on the axis (in range [-100 .. 100])
+        Int64          timestamp;  ///< Time of the event, in microseconds (see Joystick::getTimestamp)
     };
 
     ////////////////////////////////////////////////////////////
@@ -155,6 +157,7 @@ public:
     {
         unsigned int joystickId; ///< Index of the joystick (in range [0 .. Joystick::Count - 1])
         unsigned int button;     ///< Index of the button that has been pressed (in range [0 .. Joystick::ButtonCount - 1])
+        Int64        timestamp;  ///< Time of the event, in microseconds (see Joystick::getTimestamp)
     };
 
     ////////////////////////////////////////////////////////////
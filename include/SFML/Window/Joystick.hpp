@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Export.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -163,6 +164,45 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the joystick input thread
+    ///
+    /// By default, the joysticks are read when their state is
+    /// updated, typically once per frame when the window events
+    /// are polled. The input thread instead reads them as soon as
+    /// they send data, and records every change with its own
+    /// timestamp; the changes are then delivered as events by
+    /// the windows, and applied to the state returned by the
+    /// other functions, by the next update. This gives precise
+    /// timestamps and doesn't merge quick changes which happen
+    /// between two updates.
+    ///
+    /// The input thread is only supported on Linux; on the other
+    /// systems, this function fails and nothing changes.
+    ///
+    /// \param enabled True to start the input thread, false to stop it
+    ///
+    /// \return True on success, false if the input thread is not supported
+    ///
+    /// \see getTimestamp
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setInputThreadEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the clock timestamping joystick events
+    ///
+    /// The timestamp of joystick events is measured with this
+    /// clock, so comparing it with the returned time tells how
+    /// old an event is.
+    ///
+    /// \return Current time of the joystick clock
+    ///
+    /// \see setInputThreadEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getTimestamp();
 };
 
 } // namespace sf
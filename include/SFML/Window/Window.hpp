@@ -34,7 +34,7 @@
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/WindowStyle.hpp>
 #include <SFML/Window/GlResource.hpp>
-#include <SFML/System/Clock.hpp>
+#include <SFML/System/FramePacer.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
@@ -239,6 +239,37 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an event and return it, with a time limit
+    ///
+    /// This function is similar to waitEvent(Event&), but it gives
+    /// up and returns false if no event is received before
+    /// \a timeout expires. This is useful for applications that
+    /// only need to wake up on input or at a low rate, such as
+    /// tools that redraw when something changes.
+    /// \code
+    /// sf::Event event;
+    /// if (window.waitEvent(event, sf::milliseconds(500)))
+    /// {
+    ///    // process event...
+    /// }
+    /// else
+    /// {
+    ///    // no event for half a second, do some idle work...
+    /// }
+    /// \endcode
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if an event was returned, false if the timeout
+    ///         expired or any error occurred
+    ///
+    /// \see pollEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -367,14 +398,13 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Limit the framerate to a maximum fixed frequency
     ///
-    /// If a limit is set, the window will use a small delay after
-    /// each call to display() to ensure that the current frame
-    /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// If a limit is set, the window will wait after each call
+    /// to display() until the deadline of the current frame.
+    /// Deadlines are scheduled at regular intervals, so that a
+    /// frame which ends a little late doesn't delay the following
+    /// ones. The window sleeps for most of the wait and spins
+    /// during the last millisecond, which hides the granularity
+    /// of the OS scheduler at the cost of a little CPU time.
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
@@ -451,6 +481,21 @@ public:
     ////////////////////////////////////////////////////////////
     void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the last frame
+    ///
+    /// The statistics are updated by each call to display(). They
+    /// tell how long the application spent preparing the frame,
+    /// presenting it, and how many frames missed the deadline
+    /// set by setFramerateLimit.
+    ///
+    /// \return Statistics of the last displayed frame
+    ///
+    /// \see setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    const FramePacer::Stats& getFrameStats() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -488,6 +533,16 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window is displayed
+    ///
+    /// This function is called by display() so that derived
+    /// classes can finish their rendering before the buffers
+    /// are swapped.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -513,11 +568,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
-    priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
-    Vector2u          m_size;           ///< Current size of the window
+    priv::WindowImpl* m_impl;    ///< Platform-specific implementation of the window
+    priv::GlContext*  m_context; ///< Platform-specific implementation of the OpenGL context
+    FramePacer        m_pacer;   ///< Scheduler of the frames, implementing the framerate limit
+    Vector2u          m_size;    ///< Current size of the window
 };
 
 } // namespace sf
@@ -29,7 +29,7 @@
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/System/InputStream.hpp>
-#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 
@@ -68,7 +68,7 @@ bool InputSoundFile::openFromFile(const std::string& filename)
         return false;
 
     // Wrap the file into a stream
-    FileInputStream* file = new FileInputStream;
+    MappedFileInputStream* file = new MappedFileInputStream;
     m_stream = file;
     m_streamOwned = true;
 
@@ -79,6 +79,9 @@ bool InputSoundFile::openFromFile(const std::string& filename)
         return false;
     }
 
+    // Sound files are decoded from the beginning to the end
+    file->setAccessPattern(MappedFileInputStream::Sequential);
+
     // Pass the stream to the reader
     SoundFileReader::Info info;
     if (!m_reader->open(*file, info))
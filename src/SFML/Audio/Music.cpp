@@ -114,6 +114,11 @@ bool Music::onGetData(SoundStream::Chunk& data)
 {
     Lock lock(m_mutex);
 
+    // Follow changes of the buffer duration requested by the stream
+    std::size_t sampleCount = getBufferSampleCount();
+    if (m_samples.size() != sampleCount)
+        m_samples.resize(sampleCount);
+
     // Fill the chunk parameters
     data.samples     = &m_samples[0];
     data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], m_samples.size()));
@@ -138,11 +143,22 @@ void Music::initialize()
     // Compute the music duration
     m_duration = m_file.getDuration();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
-
     // Initialize the stream
     SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
+
+    // Resize the internal buffer so that it can contain one stream buffer of audio samples
+    m_samples.resize(getBufferSampleCount());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Music::getBufferSampleCount() const
+{
+    std::size_t frames = static_cast<std::size_t>(getBufferDuration().asSeconds() * m_file.getSampleRate());
+    if (frames == 0)
+        frames = 1;
+
+    return frames * m_file.getChannelCount();
 }
 
 } // namespace sf
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cassert>
+#include <cstring>
 
 
 namespace
@@ -87,7 +88,39 @@ namespace
         return true;
     }
 
+    // Read a little endian IEEE float from raw bytes, convert it to a 16 bits sample
+    template <typename T, typename U>
+    sf::Int16 decodeFloat(const unsigned char* bytes)
+    {
+        U bits = 0;
+        for (std::size_t i = 0; i < sizeof(U); ++i)
+            bits |= static_cast<U>(bytes[i]) << (i * 8);
+
+        T value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        if (!(value > -1))
+            return -32768;
+        if (value >= 1)
+            return 32767;
+        return static_cast<sf::Int16>(value * 32767);
+    }
+
+    bool isHostLittleEndian()
+    {
+        const sf::Uint16 value = 1;
+        return *reinterpret_cast<const unsigned char*>(&value) == 1;
+    }
+
     const sf::Uint64 mainChunkSize = 12;
+
+    // WAV format codes
+    const sf::Uint16 waveFormatPcm        = 0x0001;
+    const sf::Uint16 waveFormatIeeeFloat  = 0x0003;
+    const sf::Uint16 waveFormatExtensible = 0xFFFE;
+
+    // Number of samples converted at once by read()
+    const std::size_t readBlockSize = 4096;
 }
 
 namespace sf
@@ -110,7 +143,9 @@ bool SoundFileReaderWav::check(InputStream& stream)
 SoundFileReaderWav::SoundFileReaderWav() :
 m_stream        (NULL),
 m_bytesPerSample(0),
-m_dataStart     (0)
+m_isFloat       (false),
+m_dataStart     (0),
+m_dataEnd       (0)
 {
 }
 
@@ -144,49 +179,86 @@ Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
 {
     assert(m_stream);
 
+    // Don't read past the end of the data chunk
+    Int64 position = m_stream->tell();
+    if ((position < 0) || (static_cast<Uint64>(position) >= m_dataEnd))
+        return 0;
+    maxCount = std::min(maxCount, (m_dataEnd - static_cast<Uint64>(position)) / m_bytesPerSample);
+
+    // 16 bits little endian samples already have the right layout: read them in place
+    if ((m_bytesPerSample == 2) && !m_isFloat && isHostLittleEndian())
+    {
+        Int64 read = m_stream->read(samples, static_cast<Int64>(maxCount * sizeof(Int16)));
+        return read > 0 ? static_cast<Uint64>(read) / sizeof(Int16) : 0;
+    }
+
+    // Other formats are read by blocks and converted
+    m_buffer.resize(readBlockSize * m_bytesPerSample);
+
     Uint64 count = 0;
     while (count < maxCount)
     {
-        switch (m_bytesPerSample)
-        {
-            case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = (static_cast<Int16>(sample) - 128) << 8;
-                else
-                    return count;
-                break;
-            }
-
-            case 2:
-            {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
-                break;
-            }
+        std::size_t blockCount = static_cast<std::size_t>(std::min<Uint64>(maxCount - count, readBlockSize));
+        Int64 read = m_stream->read(&m_buffer[0], static_cast<Int64>(blockCount * m_bytesPerSample));
+        if (read <= 0)
+            break;
 
-            case 4:
-            {
-                Int32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample >> 16;
-                else
-                    return count;
-                break;
-            }
-        }
+        std::size_t readCount = static_cast<std::size_t>(read) / m_bytesPerSample;
+        convert(&m_buffer[0], samples + count, readCount);
+        count += readCount;
 
-        ++count;
+        if (readCount < blockCount)
+            break;
     }
 
     return count;
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundFileReaderWav::convert(const unsigned char* data, Int16* samples, std::size_t count) const
+{
+    // Integer samples are signed, except 8 bits ones; we keep their 16 most significant bits
+    if (m_isFloat)
+    {
+        if (m_bytesPerSample == 4)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                samples[i] = decodeFloat<float, Uint32>(data + i * 4);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                samples[i] = decodeFloat<double, Uint64>(data + i * 8);
+        }
+        return;
+    }
+
+    switch (m_bytesPerSample)
+    {
+        case 1:
+            for (std::size_t i = 0; i < count; ++i)
+                samples[i] = static_cast<Int16>((data[i] - 128) << 8);
+            break;
+
+        case 2:
+            for (std::size_t i = 0; i < count; ++i)
+                samples[i] = static_cast<Int16>(data[i * 2] | (data[i * 2 + 1] << 8));
+            break;
+
+        case 3:
+            for (std::size_t i = 0; i < count; ++i)
+                samples[i] = static_cast<Int16>(data[i * 3 + 1] | (data[i * 3 + 2] << 8));
+            break;
+
+        case 4:
+            for (std::size_t i = 0; i < count; ++i)
+                samples[i] = static_cast<Int16>(data[i * 4 + 2] | (data[i * 4 + 3] << 8));
+            break;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundFileReaderWav::parseHeader(Info& info)
 {
@@ -219,8 +291,6 @@ bool SoundFileReaderWav::parseHeader(Info& info)
             Uint16 format = 0;
             if (!decode(*m_stream, format))
                 return false;
-            if (format != 1) // PCM
-                return false;
 
             // Channel count
             Uint16 channelCount = 0;
@@ -248,12 +318,48 @@ bool SoundFileReaderWav::parseHeader(Info& info)
             Uint16 bitsPerSample = 0;
             if (!decode(*m_stream, bitsPerSample))
                 return false;
-            m_bytesPerSample = bitsPerSample / 8;
+            m_bytesPerSample = (bitsPerSample + 7) / 8;
+
+            Uint32 formatSize = 16;
+            if ((format == waveFormatExtensible) && (subChunkSize >= 40))
+            {
+                // Extension size, valid bits per sample, channel mask
+                Uint16 extensionSize = 0;
+                Uint16 validBits = 0;
+                Uint32 channelMask = 0;
+                if (!decode(*m_stream, extensionSize) || !decode(*m_stream, validBits) || !decode(*m_stream, channelMask))
+                    return false;
+
+                // The actual format is in the first two bytes of the sub-format GUID
+                char subFormat[16];
+                if (m_stream->read(subFormat, sizeof(subFormat)) != sizeof(subFormat))
+                    return false;
+                format = static_cast<Uint8>(subFormat[0]) | (static_cast<Uint8>(subFormat[1]) << 8);
+
+                formatSize = 40;
+            }
+
+            if (format == waveFormatPcm)
+            {
+                if ((m_bytesPerSample < 1) || (m_bytesPerSample > 4))
+                    return false;
+                m_isFloat = false;
+            }
+            else if (format == waveFormatIeeeFloat)
+            {
+                if ((m_bytesPerSample != 4) && (m_bytesPerSample != 8))
+                    return false;
+                m_isFloat = true;
+            }
+            else
+            {
+                return false;
+            }
 
-            // Skip potential extra information (should not exist for PCM)
-            if (subChunkSize > 16)
+            // Skip potential extra information
+            if (subChunkSize > formatSize)
             {
-                if (m_stream->seek(m_stream->tell() + subChunkSize - 16) == -1)
+                if (m_stream->seek(m_stream->tell() + subChunkSize - formatSize) == -1)
                     return false;
             }
         }
@@ -261,11 +367,16 @@ bool SoundFileReaderWav::parseHeader(Info& info)
         {
             // "data" chunk
 
+            // The format must be known before the data
+            if (m_bytesPerSample == 0)
+                return false;
+
             // Compute the total number of samples
             info.sampleCount = subChunkSize / m_bytesPerSample;
 
-            // Store the starting position of samples in the file
+            // Store the position of the samples in the file
             m_dataStart = m_stream->tell();
+            m_dataEnd = m_dataStart + subChunkSize;
 
             dataChunkFound = true;
         }
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -105,12 +106,25 @@ private:
     ////////////////////////////////////////////////////////////
     bool parseHeader(Info& info);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert raw samples of the file to 16 bits signed integers
+    ///
+    /// \param data    Raw samples, as stored in the file
+    /// \param samples Destination array
+    /// \param count   Number of samples to convert
+    ///
+    ////////////////////////////////////////////////////////////
+    void convert(const unsigned char* data, Int16* samples, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputStream* m_stream;         ///< Source stream to read from
-    unsigned int m_bytesPerSample; ///< Size of a sample, in bytes
-    Uint64       m_dataStart;      ///< Starting position of the audio data in the open file
+    InputStream*               m_stream;         ///< Source stream to read from
+    unsigned int               m_bytesPerSample; ///< Size of a sample, in bytes
+    bool                       m_isFloat;        ///< Are the samples stored as IEEE floats rather than integers?
+    Uint64                     m_dataStart;      ///< Starting position of the audio data in the open file
+    Uint64                     m_dataEnd;        ///< Position of the end of the audio data in the open file
+    std::vector<unsigned char> m_buffer;         ///< Temporary buffer for the raw samples read from the file
 };
 
 } // namespace priv
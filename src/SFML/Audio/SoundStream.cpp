@@ -26,22 +26,17 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/SoundStreamScheduler.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
-#include <SFML/System/Lock.hpp>
-
-#ifdef _MSC_VER
-    #pragma warning(disable: 4355) // 'this' used in base member initializer list
-#endif
+#include <SFML/System/ScopedLock.hpp>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
 m_threadMutex     (),
 m_threadStartState(Stopped),
 m_isStreaming     (false),
@@ -49,7 +44,12 @@ m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
 m_loop            (false),
-m_samplesProcessed(0)
+m_samplesProcessed(0),
+m_bufferCount     (3),
+m_bufferDuration  (seconds(1)),
+m_requestStop     (false),
+m_queuedSamples   (0),
+m_underrunCount   (0)
 {
 
 }
@@ -60,14 +60,17 @@ SoundStream::~SoundStream()
 {
     // Stop the sound if it was playing
 
-    // Request the thread to terminate
+    // Request the streaming to terminate
     {
-        Lock lock(m_threadMutex);
+        ScopedLock<FastMutex> lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Stop being updated by the streaming thread
+    priv::SoundStreamScheduler::remove(*this);
+
+    // Destroy the audio buffers
+    releaseBuffers();
 }
 
 
@@ -104,7 +107,7 @@ void SoundStream::play()
     Status threadStartState = Stopped;
 
     {
-        Lock lock(m_threadMutex);
+        ScopedLock<FastMutex> lock(m_threadMutex);
 
         isStreaming = m_isStreaming;
         threadStartState = m_threadStartState;
@@ -114,7 +117,7 @@ void SoundStream::play()
     if (isStreaming && (threadStartState == Paused))
     {
         // If the sound is paused, resume it
-        Lock lock(m_threadMutex);
+        ScopedLock<FastMutex> lock(m_threadMutex);
         m_threadStartState = Playing;
         alCheck(alSourcePlay(m_source));
         return;
@@ -125,6 +128,10 @@ void SoundStream::play()
         stop();
     }
 
+    // Make sure the streaming thread is done with the previous playback
+    priv::SoundStreamScheduler::remove(*this);
+    releaseBuffers();
+
     // Move to the beginning
     onSeek(Time::Zero);
 
@@ -132,7 +139,7 @@ void SoundStream::play()
     m_samplesProcessed = 0;
     m_isStreaming = true;
     m_threadStartState = Playing;
-    m_thread.launch();
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -141,7 +148,7 @@ void SoundStream::pause()
 {
     // Handle pause() being called before the thread has started
     {
-        Lock lock(m_threadMutex);
+        ScopedLock<FastMutex> lock(m_threadMutex);
 
         if (!m_isStreaming)
             return;
@@ -156,14 +163,17 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Request the thread to terminate
+    // Request the streaming to terminate
     {
-        Lock lock(m_threadMutex);
+        ScopedLock<FastMutex> lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Stop being updated by the streaming thread
+    priv::SoundStreamScheduler::remove(*this);
+
+    // Stop the playback and destroy the audio buffers
+    releaseBuffers();
 
     // Move to the beginning
     onSeek(Time::Zero);
@@ -195,7 +205,7 @@ SoundStream::Status SoundStream::getStatus() const
     // To compensate for the lag between play() and alSourceplay()
     if (status == Stopped)
     {
-        Lock lock(m_threadMutex);
+        ScopedLock<FastMutex> lock(m_threadMutex);
 
         if (m_isStreaming)
             status = m_threadStartState;
@@ -225,7 +235,7 @@ void SoundStream::setPlayingOffset(Time timeOffset)
 
     m_isStreaming = true;
     m_threadStartState = oldStatus;
-    m_thread.launch();
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -261,127 +271,206 @@ bool SoundStream::getLoop() const
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+void SoundStream::setBufferCount(unsigned int count)
 {
-    bool requestStop = false;
+    m_bufferCount = count < 2 ? 2 : count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    return m_bufferCount;
+}
 
-    {
-        Lock lock(m_threadMutex);
 
-        // Check if the thread was launched Stopped
-        if (m_threadStartState == Stopped)
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferDuration(Time duration)
+{
+    m_bufferDuration = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getBufferDuration() const
+{
+    return m_bufferDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getUnderrunCount() const
+{
+    ScopedLock<FastMutex> lock(m_threadMutex);
+    return m_underrunCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::updateStream(Time& nextUpdate)
+{
+    nextUpdate = milliseconds(10);
+
+    // First update: start the playback
+    if (m_buffers.empty())
+    {
         {
-            m_isStreaming = false;
-            return;
+            ScopedLock<FastMutex> lock(m_threadMutex);
+
+            // Check if the streaming was started Stopped
+            if (m_threadStartState == Stopped)
+            {
+                m_isStreaming = false;
+                return false;
+            }
         }
-    }
 
-    // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_endBuffers[i] = false;
+        // Create the buffers
+        m_buffers.resize(m_bufferCount);
+        m_endBuffers.assign(m_bufferCount, false);
+        alCheck(alGenBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
 
-    // Fill the queue
-    requestStop = fillQueue();
+        // Fill the queue
+        m_queuedSamples = 0;
+        m_requestStop = fillQueue();
 
-    // Play the sound
-    alCheck(alSourcePlay(m_source));
+        // Play the sound
+        alCheck(alSourcePlay(m_source));
 
-    {
-        Lock lock(m_threadMutex);
+        {
+            ScopedLock<FastMutex> lock(m_threadMutex);
 
-        // Check if the thread was launched Paused
-        if (m_threadStartState == Paused)
-            alCheck(alSourcePause(m_source));
+            // Check if the streaming was started Paused
+            if (m_threadStartState == Paused)
+                alCheck(alSourcePause(m_source));
+        }
     }
 
-    for (;;)
     {
+        ScopedLock<FastMutex> lock(m_threadMutex);
+        if (!m_isStreaming)
         {
-            Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
+            releaseBuffers();
+            return false;
         }
+    }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (!m_requestStop)
         {
-            if (!requestStop)
+            // The source ran out of data: count the underrun and just continue
             {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
+                ScopedLock<FastMutex> lock(m_threadMutex);
+                ++m_underrunCount;
             }
-            else
+            alCheck(alSourcePlay(m_source));
+        }
+        else
+        {
+            // End streaming
+            ScopedLock<FastMutex> lock(m_threadMutex);
+            m_isStreaming = false;
+        }
+    }
+
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+            if (m_buffers[i] == buffer)
             {
-                // End streaming
-                Lock lock(m_threadMutex);
-                m_isStreaming = false;
+                bufferNum = static_cast<unsigned int>(i);
+                break;
             }
+
+        // Retrieve its size and remove it from the queued samples count
+        ALint size, bits;
+        alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+        alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+        // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+        if (bits == 0)
+        {
+            err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                  << "and initialize() has been called correctly" << std::endl;
+
+            // Abort streaming
+            ScopedLock<FastMutex> lock(m_threadMutex);
+            m_isStreaming = false;
+            m_requestStop = true;
+            break;
         }
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+        Uint64 samples = static_cast<Uint64>(size / (bits / 8));
+        m_queuedSamples = (m_queuedSamples > samples) ? m_queuedSamples - samples : 0;
 
-        while (nbProcessed--)
+        // Add it to the samples count
+        if (m_endBuffers[bufferNum])
         {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_endBuffers[bufferNum])
-            {
-                // This was the last buffer: reset the sample count
-                m_samplesProcessed = 0;
-                m_endBuffers[bufferNum] = false;
-            }
-            else
-            {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
-            }
+            // This was the last buffer: reset the sample count
+            m_samplesProcessed = 0;
+            m_endBuffers[bufferNum] = false;
+        }
+        else
+        {
+            m_samplesProcessed += samples;
+        }
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+    {
+        ScopedLock<FastMutex> lock(m_threadMutex);
+        if (!m_isStreaming)
+        {
+            releaseBuffers();
+            return false;
+        }
     }
 
+    // Come back when half of the queued audio has been played, so that
+    // slow sources get called often and long queues cost few wake-ups
+    if (m_channelCount && m_sampleRate)
+    {
+        ALint offset = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+        Uint64 queuedFrames = m_queuedSamples / m_channelCount;
+        Uint64 playedFrames = static_cast<Uint64>(offset > 0 ? offset : 0);
+        Uint64 remaining    = queuedFrames > playedFrames ? queuedFrames - playedFrames : 0;
+
+        nextUpdate = microseconds(static_cast<Int64>(remaining * 500000 / m_sampleRate));
+    }
+
+    if (nextUpdate < milliseconds(1))
+        nextUpdate = milliseconds(1);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::releaseBuffers()
+{
+    if (m_buffers.empty())
+        return;
+
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -390,7 +479,11 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
+
+    m_buffers.clear();
+    m_endBuffers.clear();
+    m_queuedSamples = 0;
 }
 
 
@@ -436,6 +529,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
+        m_queuedSamples += data.sampleCount;
     }
 
     return requestStop;
@@ -447,9 +541,9 @@ bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (std::size_t i = 0; (i < m_buffers.size()) && !requestStop; ++i)
     {
-        if (fillAndPushBuffer(i))
+        if (fillAndPushBuffer(static_cast<unsigned int>(i)))
             requestStop = true;
     }
 
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundStreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ScopedLock.hpp>
+#include <SFML/System/SpinLock.hpp>
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // The scheduler is created on first use and never destroyed, so
+    // that streams destroyed during static destruction can still use it;
+    // the lock protecting its creation has no destructor for the same
+    // reason, and its zero-initialized state is already valid
+    sf::SpinLock instanceLock;
+    sf::priv::SoundStreamScheduler* instance = NULL;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SoundStreamScheduler::SoundStreamScheduler() :
+m_thread (&SoundStreamScheduler::run, this),
+m_running(false),
+m_wakeUp (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::add(SoundStream& stream)
+{
+    SoundStreamScheduler& scheduler = getInstance();
+
+    ScopedLock<FastMutex> lock(scheduler.m_mutex);
+
+    if (std::find(scheduler.m_streams.begin(), scheduler.m_streams.end(), &stream) == scheduler.m_streams.end())
+        scheduler.m_streams.push_back(&stream);
+
+    // Start the thread if it has stopped; if it is still returning
+    // after its last stream was removed, launch() waits for it first
+    if (!scheduler.m_running)
+    {
+        scheduler.m_running = true;
+        scheduler.m_wakeUp = false;
+        scheduler.m_thread.launch();
+    }
+    else
+    {
+        // The thread may be waiting for the next update of the other
+        // streams, which can be far away: the new one must start now
+        scheduler.m_wakeUp = true;
+        scheduler.m_condition.notifyOne();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::remove(SoundStream& stream)
+{
+    SoundStreamScheduler& scheduler = getInstance();
+
+    // Wait until the stream is not being updated anymore
+    Lock serviceLock(scheduler.m_serviceMutex);
+    ScopedLock<FastMutex> lock(scheduler.m_mutex);
+
+    std::vector<SoundStream*>::iterator it = std::find(scheduler.m_streams.begin(), scheduler.m_streams.end(), &stream);
+    if (it != scheduler.m_streams.end())
+    {
+        scheduler.m_streams.erase(it);
+
+        // Let the thread return now rather than after its next timeout
+        if (scheduler.m_streams.empty())
+        {
+            scheduler.m_wakeUp = true;
+            scheduler.m_condition.notifyOne();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStreamScheduler& SoundStreamScheduler::getInstance()
+{
+    ScopedLock<SpinLock> lock(instanceLock);
+
+    if (!instance)
+        instance = new SoundStreamScheduler;
+
+    return *instance;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::run()
+{
+    std::vector<SoundStream*> streams;
+
+    for (;;)
+    {
+        // Take a snapshot of the streams to update
+        {
+            ScopedLock<FastMutex> lock(m_mutex);
+
+            if (m_streams.empty())
+            {
+                m_running = false;
+                return;
+            }
+
+            streams = m_streams;
+        }
+
+        // Each stream tells when it must be updated again, depending on
+        // how much audio it has queued; there is no upper bound since
+        // add() wakes the thread up when a new stream needs an update
+        Time nextUpdate = Time::Zero;
+        bool updatedAny = false;
+
+        for (std::vector<SoundStream*>::iterator it = streams.begin(); it != streams.end(); ++it)
+        {
+            Lock serviceLock(m_serviceMutex);
+
+            // The stream may have been removed since the snapshot was taken
+            {
+                ScopedLock<FastMutex> lock(m_mutex);
+                if (std::find(m_streams.begin(), m_streams.end(), *it) == m_streams.end())
+                    continue;
+            }
+
+            Time streamUpdate;
+            if ((*it)->updateStream(streamUpdate))
+            {
+                nextUpdate = updatedAny ? std::min(nextUpdate, streamUpdate) : streamUpdate;
+                updatedAny = true;
+            }
+            else
+            {
+                // The stream is finished
+                ScopedLock<FastMutex> lock(m_mutex);
+                m_streams.erase(std::find(m_streams.begin(), m_streams.end(), *it));
+            }
+        }
+
+        // Wait until the stream which needs it first must be updated
+        // again, or until a stream is added or the last one removed
+        ScopedLock<FastMutex> lock(m_mutex);
+
+        Clock clock;
+        while (!m_wakeUp && (clock.getElapsedTime() < nextUpdate))
+        {
+            if (!m_condition.wait(m_mutex, nextUpdate - clock.getElapsedTime()))
+                break;
+        }
+
+        m_wakeUp = false;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDSTREAMSCHEDULER_HPP
+#define SFML_SOUNDSTREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Thread shared by all the sound streams, which
+///        keeps their audio queues filled
+///
+////////////////////////////////////////////////////////////
+class SoundStreamScheduler : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start updating a stream
+    ///
+    /// The streaming thread is launched if it is not running,
+    /// or woken up so that the stream gets its first update
+    /// right away. Adding a stream which is already updated
+    /// only wakes the thread up.
+    ///
+    /// \param stream Stream to update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop updating a stream
+    ///
+    /// When this function returns, the streaming thread is
+    /// guaranteed not to be using the stream anymore.
+    ///
+    /// \param stream Stream to stop updating
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(SoundStream& stream);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundStreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique instance, create it if necessary
+    ///
+    /// \return Reference to the scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    static SoundStreamScheduler& getInstance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the thread
+    ///
+    /// The thread returns as soon as there is no stream left
+    /// to update, so that idle programs don't wake up for nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread                    m_thread;        ///< Thread updating the streams
+    FastMutex                 m_mutex;         ///< Mutex protecting the list of streams and the flags
+    ConditionVariable         m_condition;     ///< Condition used to wake the thread up before its next update
+    Mutex                     m_serviceMutex;  ///< Mutex held while a stream is being updated
+    std::vector<SoundStream*> m_streams;       ///< Streams being updated
+    bool                      m_running;       ///< Is the thread running?
+    bool                      m_wakeUp;        ///< Must the thread stop waiting and update the streams now?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDSTREAMSCHEDULER_HPP
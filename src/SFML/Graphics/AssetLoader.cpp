@@ -0,0 +1,449 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AssetLoader.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ScopedLock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Approximate number of bytes uploaded per slice; small enough for
+    // a slice to take a fraction of a millisecond on common hardware
+    const unsigned int sliceSize = 256 * 1024;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief State of a request, shared by the loader and its futures
+///
+////////////////////////////////////////////////////////////
+struct AssetLoaderState
+{
+    AssetLoaderState() :
+    status  (AssetLoader::Future::Pending),
+    refCount(1)
+    {
+    }
+
+    FastMutex                   mutex;     ///< Mutex protecting the state
+    ConditionVariable           completed; ///< Signaled when the request completes
+    AssetLoader::Future::Status status;    ///< Current status of the request
+    unsigned int                refCount;  ///< Number of owners of the state
+};
+
+} // namespace priv
+} // namespace sf
+
+
+namespace
+{
+////////////////////////////////////////////////////////////
+void acquireState(sf::priv::AssetLoaderState* state)
+{
+    if (state)
+    {
+        sf::ScopedLock<sf::FastMutex> lock(state->mutex);
+        state->refCount++;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void releaseState(sf::priv::AssetLoaderState* state)
+{
+    if (state)
+    {
+        bool destroy;
+        {
+            sf::ScopedLock<sf::FastMutex> lock(state->mutex);
+            destroy = (--state->refCount == 0);
+        }
+
+        if (destroy)
+            delete state;
+    }
+}
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct AssetLoader::Request
+{
+    std::string             filename;     ///< Path of the image file to load
+    Image*                  image;        ///< Target image (image requests)
+    Texture*                texture;      ///< Target texture (texture requests)
+    Image                   staging;      ///< Decoded pixels waiting to be uploaded (texture requests)
+    unsigned int            uploadedRows; ///< Number of rows already uploaded to the texture
+    priv::AssetLoaderState* state;        ///< State shared with the futures
+};
+
+
+////////////////////////////////////////////////////////////
+struct AssetLoader::Worker
+{
+    Worker(AssetLoader& loader) :
+    thread (&AssetLoader::work, this),
+    owner  (loader),
+    running(false)
+    {
+    }
+
+    Thread       thread;  ///< Thread decoding the images
+    AssetLoader& owner;   ///< Loader owning the worker
+    bool         running; ///< Is the thread processing requests?
+};
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future::Future() :
+m_state(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future::Future(const Future& copy) :
+m_state(copy.m_state)
+{
+    acquireState(m_state);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future::Future(priv::AssetLoaderState* state) :
+m_state(state)
+{
+    acquireState(m_state);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future::~Future()
+{
+    releaseState(m_state);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future& AssetLoader::Future::operator =(const Future& right)
+{
+    acquireState(right.m_state);
+    releaseState(m_state);
+    m_state = right.m_state;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future::Status AssetLoader::Future::getStatus() const
+{
+    if (!m_state)
+        return Invalid;
+
+    ScopedLock<FastMutex> lock(m_state->mutex);
+    return m_state->status;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future::Status AssetLoader::Future::wait() const
+{
+    if (!m_state)
+        return Invalid;
+
+    ScopedLock<FastMutex> lock(m_state->mutex);
+    while (m_state->status == Pending)
+        m_state->completed.wait(m_state->mutex);
+
+    return m_state->status;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::AssetLoader(unsigned int workerCount) :
+m_workerCount     (std::max(workerCount, 1u)),
+m_pendingCount    (0),
+m_backgroundUpload(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::~AssetLoader()
+{
+    // Cancel the requests that are not being decoded
+    std::deque<Request*> canceled;
+    {
+        Lock lock(m_mutex);
+        canceled.swap(m_decodeQueue);
+    }
+
+    for (std::deque<Request*>::iterator it = canceled.begin(); it != canceled.end(); ++it)
+        complete(*it, false);
+
+    // Wait for the images being decoded
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->thread.wait();
+        delete *it;
+    }
+
+    // Cancel the textures which were not uploaded
+    for (std::deque<Request*>::iterator it = m_uploadQueue.begin(); it != m_uploadQueue.end(); ++it)
+        complete(*it, false);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future AssetLoader::loadImage(const std::string& filename, Image& image)
+{
+    Request* request = new Request;
+    request->filename = filename;
+    request->image = &image;
+    request->texture = NULL;
+
+    return push(request);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future AssetLoader::loadTexture(const std::string& filename, Texture& texture)
+{
+    Request* request = new Request;
+    request->filename = filename;
+    request->image = NULL;
+    request->texture = &texture;
+
+    return push(request);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AssetLoader::upload(Time budget)
+{
+    Clock clock;
+    unsigned int completed = 0;
+
+    do
+    {
+        // Only this function removes requests from the upload queue,
+        // so the front request stays valid once the mutex is released
+        Request* request;
+        {
+            Lock lock(m_mutex);
+            if (m_uploadQueue.empty())
+                break;
+
+            request = m_uploadQueue.front();
+        }
+
+        Vector2u size = request->staging.getSize();
+        bool success = true;
+
+        // Allocate the texture before its first slice
+        if (request->uploadedRows == 0)
+            success = request->texture->create(size.x, size.y);
+
+        if (success)
+        {
+            unsigned int rows = std::max(sliceSize / (size.x * 4), 1u);
+            rows = std::min(rows, size.y - request->uploadedRows);
+
+            const Uint8* pixels = request->staging.getPixelsPtr() + request->uploadedRows * size.x * 4;
+            request->texture->update(pixels, size.x, rows, 0, request->uploadedRows);
+            request->uploadedRows += rows;
+        }
+
+        if (!success || (request->uploadedRows == size.y))
+        {
+            {
+                Lock lock(m_mutex);
+                m_uploadQueue.pop_front();
+            }
+
+            complete(request, success);
+            completed++;
+        }
+    }
+    while (clock.getElapsedTime() < budget);
+
+    return completed;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetLoader::setBackgroundUpload(bool enabled)
+{
+    Lock lock(m_mutex);
+    m_backgroundUpload = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AssetLoader::getPendingCount() const
+{
+    Lock lock(m_mutex);
+    return m_pendingCount;
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Future AssetLoader::push(Request* request)
+{
+    request->uploadedRows = 0;
+    request->state = new priv::AssetLoaderState;
+
+    Future future(request->state);
+
+    Lock lock(m_mutex);
+
+    m_decodeQueue.push_back(request);
+    m_pendingCount++;
+
+    // Start an idle worker, or create a new one if the pool is not full
+    Worker* worker = NULL;
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        if (!(*it)->running)
+        {
+            worker = *it;
+            break;
+        }
+    }
+
+    if (!worker && (m_workers.size() < m_workerCount))
+    {
+        worker = new Worker(*this);
+        m_workers.push_back(worker);
+    }
+
+    // If all the workers are busy, one of them will pick the request
+    // up when it is done with its current one
+    if (worker)
+    {
+        worker->running = true;
+        worker->thread.launch();
+    }
+
+    return future;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetLoader::work(Worker* worker)
+{
+    AssetLoader& loader = worker->owner;
+
+    // Context used for background uploads, created on first use
+    Context* context = NULL;
+
+    for (;;)
+    {
+        Request* request;
+        bool backgroundUpload;
+        {
+            Lock lock(loader.m_mutex);
+
+            if (loader.m_decodeQueue.empty())
+            {
+                worker->running = false;
+                break;
+            }
+
+            request = loader.m_decodeQueue.front();
+            loader.m_decodeQueue.pop_front();
+            backgroundUpload = loader.m_backgroundUpload;
+        }
+
+        if (request->image)
+        {
+            // Image request: decode straight into the target
+            loader.complete(request, request->image->loadFromFile(request->filename));
+        }
+        else if (!request->staging.loadFromFile(request->filename))
+        {
+            loader.complete(request, false);
+        }
+        else if (backgroundUpload)
+        {
+            // Upload with a context of our own; it shares its textures
+            // with all the other contexts, and the flush makes sure that
+            // they see the complete texture
+            if (!context)
+                context = new Context;
+
+            bool success = request->texture->loadFromImage(request->staging);
+            glCheck(glFlush());
+
+            loader.complete(request, success);
+        }
+        else
+        {
+            // Leave the upload to the rendering thread
+            Lock lock(loader.m_mutex);
+            loader.m_uploadQueue.push_back(request);
+        }
+    }
+
+    delete context;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetLoader::complete(Request* request, bool success)
+{
+    {
+        ScopedLock<FastMutex> lock(request->state->mutex);
+        request->state->status = success ? Future::Ready : Future::Failed;
+        request->state->completed.notifyAll();
+    }
+
+    releaseState(request->state);
+    delete request;
+
+    Lock lock(m_mutex);
+    m_pendingCount--;
+}
+
+} // namespace sf
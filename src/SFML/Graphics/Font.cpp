@@ -37,6 +37,8 @@
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 
@@ -60,6 +62,24 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Small padding left around glyphs, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int glyphPadding = 1;
+
+    // Glyph rasterized by Font::preloadGlyphs, waiting to be uploaded
+    struct PendingGlyph
+    {
+        sf::Uint32  key;    // Key of the glyph in the glyph table
+        sf::Glyph   glyph;  // Glyph, its texture rect is relative to the staging block
+        std::size_t offset; // Offset of the glyph's pixels in the staging pixel array
+    };
+
+    // Sort pending glyphs by decreasing height, to pack them in shelves
+    bool isTaller(const PendingGlyph& left, const PendingGlyph& right)
+    {
+        return left.glyph.textureRect.height > right.glyph.textureRect.height;
+    }
 }
 
 
@@ -87,7 +107,8 @@ m_streamRec  (copy.m_streamRec),
 m_refCount   (copy.m_refCount),
 m_info       (copy.m_info),
 m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_pixelBuffer(copy.m_pixelBuffer),
+m_charIndices(copy.m_charIndices)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -292,24 +313,146 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    Page& page = m_pages[characterSize];
+
+    // Latin-1 glyphs, the most common ones, are directly indexed by code point
+    bool isLatin = (codePoint < 256);
+    std::size_t latinIndex = (bold ? 256 : 0) + codePoint;
+    if (isLatin && page.latinLoaded[latinIndex])
+        return page.latinGlyphs[latinIndex];
 
     // Build the key by combining the code point and the bold flag
     Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
-    {
-        // Found: just return it
-        return it->second;
-    }
-    else
+    GlyphTable::const_iterator it = page.glyphs.find(key);
+    if (it == page.glyphs.end())
     {
         // Not found: we have to load it
         Glyph glyph = loadGlyph(codePoint, characterSize, bold);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        it = page.glyphs.insert(std::make_pair(key, glyph)).first;
     }
+
+    if (isLatin)
+    {
+        page.latinGlyphs[latinIndex] = it->second;
+        page.latinLoaded[latinIndex] = true;
+    }
+
+    return it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold) const
+{
+    Page& page = m_pages[characterSize];
+
+    // Collect the code points which are not loaded yet, without duplicates
+    std::vector<Uint32> codePoints(characters.begin(), characters.end());
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+
+    // Rasterize them all, and store their pixels one after the other
+    std::vector<PendingGlyph> pending;
+    std::vector<Uint8> glyphPixels;
+    unsigned int maxWidth = 0;
+    Uint64 totalArea = 0;
+    for (std::vector<Uint32>::const_iterator it = codePoints.begin(); it != codePoints.end(); ++it)
+    {
+        Uint32 key = ((bold ? 1 : 0) << 31) | *it;
+        if (page.glyphs.find(key) != page.glyphs.end())
+            continue;
+
+        Glyph glyph = rasterizeGlyph(*it, characterSize, bold);
+        if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
+        {
+            PendingGlyph entry;
+            entry.key = key;
+            entry.glyph = glyph;
+            entry.offset = glyphPixels.size();
+            pending.push_back(entry);
+
+            glyphPixels.insert(glyphPixels.end(), m_pixelBuffer.begin(), m_pixelBuffer.begin() + glyph.textureRect.width * glyph.textureRect.height * 4);
+
+            unsigned int width  = glyph.textureRect.width + 2 * glyphPadding;
+            unsigned int height = glyph.textureRect.height + 2 * glyphPadding;
+            maxWidth = std::max(maxWidth, width);
+            totalArea += static_cast<Uint64>(width) * height;
+        }
+        else
+        {
+            // Nothing to draw (e.g. a space): the glyph can be stored right away
+            page.glyphs.insert(std::make_pair(key, glyph));
+        }
+    }
+
+    if (pending.empty())
+        return;
+
+    // Pack the glyphs into a block, in shelves of decreasing height; the block
+    // is roughly square so that it fits well into the texture
+    std::stable_sort(pending.begin(), pending.end(), isTaller);
+    unsigned int blockWidth = static_cast<unsigned int>(std::sqrt(static_cast<double>(totalArea))) + 1;
+    blockWidth = std::min(std::max(blockWidth, maxWidth), Texture::getMaximumSize());
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int shelfHeight = 0;
+    for (std::vector<PendingGlyph>::iterator it = pending.begin(); it != pending.end(); ++it)
+    {
+        unsigned int width  = it->glyph.textureRect.width + 2 * glyphPadding;
+        unsigned int height = it->glyph.textureRect.height + 2 * glyphPadding;
+        if (x + width > blockWidth)
+        {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        it->glyph.textureRect.left = x + glyphPadding;
+        it->glyph.textureRect.top = y + glyphPadding;
+        x += width;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+    unsigned int blockHeight = y + shelfHeight;
+
+    // Find a place for the whole block into the texture
+    IntRect block = findGlyphRect(page, blockWidth, blockHeight);
+    if ((block.width != static_cast<int>(blockWidth)) || (block.height != static_cast<int>(blockHeight)))
+    {
+        // The block doesn't fit into the texture: fall back to loading the glyphs one by one
+        for (std::vector<PendingGlyph>::iterator it = pending.begin(); it != pending.end(); ++it)
+            page.glyphs.insert(std::make_pair(it->key, loadGlyph(it->key & 0x7FFFFFFF, characterSize, bold)));
+        return;
+    }
+
+    // Copy the glyphs into a transparent staging image of the block
+    std::vector<Uint8> blockPixels(blockWidth * blockHeight * 4, 255);
+    for (std::size_t i = 3; i < blockPixels.size(); i += 4)
+        blockPixels[i] = 0;
+
+    for (std::vector<PendingGlyph>::iterator it = pending.begin(); it != pending.end(); ++it)
+    {
+        IntRect& rect = it->glyph.textureRect;
+        const Uint8* src = &glyphPixels[it->offset];
+        for (int row = 0; row < rect.height; ++row)
+        {
+            Uint8* dst = &blockPixels[((rect.top + row) * blockWidth + rect.left) * 4];
+            std::memcpy(dst, src + row * rect.width * 4, rect.width * 4);
+        }
+
+        // Make the texture rect absolute, and store the glyph
+        rect.left += block.left;
+        rect.top += block.top;
+        page.glyphs.insert(std::make_pair(it->key, it->glyph));
+    }
+
+    // Upload all the glyphs at once
+    page.texture.update(&blockPixels[0], blockWidth, blockHeight, block.left, block.top);
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
 }
 
 
@@ -322,28 +465,46 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    // Invalid font, or no kerning
+    if (!face || !FT_HAS_KERNING(face))
+        return 0.f;
+
+    // Search the kerning into the cache of the page; a page (and its
+    // texture) is not worth creating just for a kerning query, so the
+    // result is only cached if the page already exists
+    KerningTable* kerningTable = NULL;
+    Uint64 key = (static_cast<Uint64>(first) << 32) | second;
+    PageTable::iterator page = m_pages.find(characterSize);
+    if (page != m_pages.end())
+    {
+        kerningTable = &page->second.kerning;
+        KerningTable::const_iterator it = kerningTable->find(key);
+        if (it != kerningTable->end())
+            return it->second;
+    }
+
+    float kerning = 0.f;
+    if (setCurrentSize(characterSize))
     {
         // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        FT_UInt index1 = getCharIndex(first);
+        FT_UInt index2 = getCharIndex(second);
 
         // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+        FT_Vector vector;
+        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &vector);
 
         // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
-
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
-    }
-    else
-    {
-        // Invalid font, or no kerning
-        return 0.f;
+        if (FT_IS_SCALABLE(face))
+            kerning = static_cast<float>(vector.x) / static_cast<float>(1 << 6);
+        else
+            kerning = static_cast<float>(vector.x);
     }
+
+    if (kerningTable)
+        kerningTable->insert(std::make_pair(key, kerning));
+
+    return kerning;
 }
 
 
@@ -410,6 +571,29 @@ const Texture& Font::getTexture(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+Font::PageStats Font::getPageStats(unsigned int characterSize) const
+{
+    PageStats stats;
+    stats.textureSize = Vector2u(0, 0);
+    stats.glyphCount = 0;
+    stats.usedArea = 0;
+    stats.resizeCount = 0;
+
+    PageTable::const_iterator it = m_pages.find(characterSize);
+    if (it != m_pages.end())
+    {
+        const Page& page = it->second;
+        stats.textureSize = page.texture.getSize();
+        stats.glyphCount = page.glyphs.size();
+        stats.usedArea = page.usedArea;
+        stats.resizeCount = page.resizeCount;
+    }
+
+    return stats;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator =(const Font& right)
 {
@@ -422,6 +606,7 @@ Font& Font::operator =(const Font& right)
     std::swap(m_info,        temp.m_info);
     std::swap(m_pages,       temp.m_pages);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_charIndices, temp.m_charIndices);
 
     return *this;
 }
@@ -463,11 +648,54 @@ void Font::cleanup()
     m_refCount  = NULL;
     m_pages.clear();
     m_pixelBuffer.clear();
+    m_charIndices.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
+{
+    // Rasterize the glyph into the pixel buffer
+    Glyph glyph = rasterizeGlyph(codePoint, characterSize, bold);
+
+    if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
+    {
+        // Get the glyphs page corresponding to the character size
+        Page& page = m_pages[characterSize];
+
+        // Find a good position for the new glyph into the texture
+        unsigned int w = glyph.textureRect.width;
+        unsigned int h = glyph.textureRect.height;
+        glyph.textureRect = findGlyphRect(page, w + 2 * glyphPadding, h + 2 * glyphPadding);
+        if ((glyph.textureRect.width != static_cast<int>(w + 2 * glyphPadding)) || (glyph.textureRect.height != static_cast<int>(h + 2 * glyphPadding)))
+        {
+            // Oops, we've reached the maximum texture size...
+            err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+        }
+
+        // Make sure the texture data is positioned in the center
+        // of the allocated texture rectangle
+        glyph.textureRect.left += glyphPadding;
+        glyph.textureRect.top += glyphPadding;
+        glyph.textureRect.width -= 2 * glyphPadding;
+        glyph.textureRect.height -= 2 * glyphPadding;
+
+        // Write the pixels to the texture
+        unsigned int x = glyph.textureRect.left;
+        unsigned int y = glyph.textureRect.top;
+        page.texture.update(&m_pixelBuffer[0], glyph.textureRect.width, glyph.textureRect.height, x, y);
+    }
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::rasterizeGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
     // The glyph to return
     Glyph glyph;
@@ -482,7 +710,7 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
         return glyph;
 
     // Load the glyph corresponding to the code point
-    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+    if (FT_Load_Glyph(face, getCharIndex(codePoint), FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
         return glyph;
 
     // Retrieve the glyph
@@ -519,22 +747,8 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
 
     if ((width > 0) && (height > 0))
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
-
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
-
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+        // Only the size of the texture rect is known at this point
+        glyph.textureRect = IntRect(0, 0, width, height);
 
         // Compute the glyph's bounding box
         glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
@@ -573,22 +787,11 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
                 pixels += bitmap.pitch;
             }
         }
-
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left;
-        unsigned int y = glyph.textureRect.top;
-        unsigned int w = glyph.textureRect.width;
-        unsigned int h = glyph.textureRect.height;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
     }
 
     // Delete the FT glyph
     FT_Done_Glyph(glyphDesc);
 
-    // Force an OpenGL flush, so that the font's texture will appear updated
-    // in all contexts immediately (solves problems in multi-threaded apps)
-    glCheck(glFlush());
-
     // Done :)
     return glyph;
 }
@@ -597,68 +800,129 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
 ////////////////////////////////////////////////////////////
 IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
+    for (;;)
     {
-        float ratio = static_cast<float>(height) / it->height;
+        // Find the position where the glyph ends up the lowest in the texture
+        // (bottom-left skyline heuristic); on ties, prefer the narrowest segment
+        // so that the wider ones are kept for wider glyphs
+        std::size_t bestIndex = page.skyline.size();
+        unsigned int bestTop = 0;
+        unsigned int bestWidth = 0;
+        for (std::size_t i = 0; i < page.skyline.size(); ++i)
+        {
+            unsigned int left = page.skyline[i].left;
+            if (left + width > page.texture.getSize().x)
+                break;
+
+            // The glyph rests on the highest of the segments that it covers
+            unsigned int top = 0;
+            unsigned int covered = 0;
+            for (std::size_t j = i; covered < width; ++j)
+            {
+                top = std::max(top, page.skyline[j].top);
+                covered += page.skyline[j].width;
+            }
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
+            if (top + height > page.texture.getSize().y)
+                continue;
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+            if ((bestIndex == page.skyline.size()) || (top < bestTop) ||
+                ((top == bestTop) && (page.skyline[i].width < bestWidth)))
+            {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = page.skyline[i].width;
+            }
+        }
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+        if (bestIndex < page.skyline.size())
+        {
+            unsigned int left = page.skyline[bestIndex].left;
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
-    }
+            // Insert the new segment on top of the glyph
+            page.skyline.insert(page.skyline.begin() + bestIndex, SkylineNode(left, bestTop + height, width));
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
-    {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
-        {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
+            // Shrink or remove the segments that are now covered by the glyph
+            for (std::size_t i = bestIndex + 1; i < page.skyline.size(); )
             {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
+                SkylineNode& node = page.skyline[i];
+                if (node.left >= left + width)
+                    break;
+
+                unsigned int shrink = left + width - node.left;
+                if (shrink < node.width)
+                {
+                    node.left += shrink;
+                    node.width -= shrink;
+                    break;
+                }
+
+                page.skyline.erase(page.skyline.begin() + i);
             }
-            else
+
+            // Merge adjacent segments that have the same height
+            for (std::size_t i = 0; i + 1 < page.skyline.size(); )
             {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
+                if (page.skyline[i].top == page.skyline[i + 1].top)
+                {
+                    page.skyline[i].width += page.skyline[i + 1].width;
+                    page.skyline.erase(page.skyline.begin() + i + 1);
+                }
+                else
+                {
+                    ++i;
+                }
             }
+
+            page.usedArea += static_cast<Uint64>(width) * height;
+
+            return IntRect(left, bestTop, width, height);
         }
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+        // Not enough space: resize the texture if possible; if it can't
+        // grow anymore, the caller decides whether this is an error
+        if (!resizePage(page))
+            return IntRect(0, 0, 2, 2);
     }
+}
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
 
-    // Update the row informations
-    row->width += width;
+////////////////////////////////////////////////////////////
+bool Font::resizePage(Page& page) const
+{
+    unsigned int textureWidth  = page.texture.getSize().x;
+    unsigned int textureHeight = page.texture.getSize().y;
+    if ((textureWidth * 2 > Texture::getMaximumSize()) || (textureHeight * 2 > Texture::getMaximumSize()))
+        return false;
+
+    // Make the texture 2 times bigger; the old pixels are copied
+    // on the graphics card, without reading them back
+    Texture newTexture;
+    if (!newTexture.create(textureWidth * 2, textureHeight * 2))
+        return false;
+
+    // The new area must be transparent, since glyphs only upload their
+    // inner rectangle and smoothing samples the padding around them
+    std::vector<Uint8> transparent(textureWidth * textureHeight * 2 * 4);
+    for (std::size_t i = 0; i < transparent.size(); i += 4)
+    {
+        transparent[i + 0] = 255;
+        transparent[i + 1] = 255;
+        transparent[i + 2] = 255;
+        transparent[i + 3] = 0;
+    }
+    newTexture.update(&transparent[0], textureWidth, textureHeight * 2, textureWidth, 0);
+    newTexture.update(&transparent[0], textureWidth, textureHeight, 0, textureHeight);
+
+    newTexture.setSmooth(page.texture.isSmooth());
+    newTexture.update(page.texture);
+    page.texture.swap(newTexture);
+    ++page.resizeCount;
+
+    // The new area on the right is empty
+    page.skyline.push_back(SkylineNode(textureWidth, 0, textureWidth));
 
-    return rect;
+    return true;
 }
 
 
@@ -698,9 +962,26 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int Font::getCharIndex(Uint32 codePoint) const
+{
+    CharIndexTable::const_iterator it = m_charIndices.find(codePoint);
+    if (it != m_charIndices.end())
+        return it->second;
+
+    unsigned int index = FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint);
+    m_charIndices.insert(std::make_pair(codePoint, index));
+
+    return index;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+usedArea   (0),
+resizeCount(0),
+latinGlyphs(512),
+latinLoaded(512, false)
 {
     // Make sure that the texture is initialized by default
     sf::Image image;
@@ -714,6 +995,9 @@ nextRow(3)
     // Create the texture
     texture.loadFromImage(image);
     texture.setSmooth(true);
+
+    // Start the skyline just below the white square
+    skyline.push_back(SkylineNode(0, 3, image.getSize().x));
 }
 
 } // namespace sf
@@ -29,14 +29,28 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Instance.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TransformPoints.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <map>
 
 namespace
 {
+    // Render target that was last activated in each OpenGL context, so that
+    // the targets sharing a context know when they must set their states again
+    sf::Mutex mutex;
+    std::map<sf::Uint64, sf::Uint64> contextTargets;
+    sf::Uint64 nextTargetId = 1;
+
     // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
     sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
     {
@@ -73,6 +87,91 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // Get the list primitive type that can represent the given primitives.
+    sf::PrimitiveType getListPrimitiveType(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::LinesStrip:     return sf::Lines;
+            case sf::TrianglesStrip: return sf::Triangles;
+            case sf::TrianglesFan:   return sf::Triangles;
+            default:                 return type;
+        }
+    }
+
+
+    // Get the number of vertices needed to represent the given primitives as a list.
+    std::size_t getListVertexCount(sf::PrimitiveType type, std::size_t vertexCount)
+    {
+        switch (type)
+        {
+            case sf::LinesStrip:     return vertexCount >= 2 ? 2 * (vertexCount - 1) : 0;
+            case sf::TrianglesStrip: return vertexCount >= 3 ? 3 * (vertexCount - 2) : 0;
+            case sf::TrianglesFan:   return vertexCount >= 3 ? 3 * (vertexCount - 2) : 0;
+
+            // Incomplete primitives at the end of a list are ignored by OpenGL,
+            // but they would shift the primitives that follow in a merged list
+            case sf::Lines:          return vertexCount - vertexCount % 2;
+            case sf::Triangles:      return vertexCount - vertexCount % 3;
+            case sf::Quads:          return vertexCount - vertexCount % 4;
+            default:                 return vertexCount;
+        }
+    }
+
+
+    // Transform the positions of an array of vertices, leaving their other attributes untouched.
+    void transformVertices(const sf::Transform& transform, const sf::Vertex* vertices, sf::Vertex* output, std::size_t count)
+    {
+        const std::size_t stride = sizeof(sf::Vertex) / sizeof(float);
+        sf::priv::transformPoints(transform.getMatrix(), &vertices[0].position.x, stride, &output[0].position.x, stride, count);
+    }
+
+
+    // Pre-transform and color vertices while converting them to the equivalent list of primitives;
+    // the output must have room for getListVertexCount(type, vertexCount) vertices.
+    void unrollVertices(sf::Vertex* output, const sf::Vertex* vertices, std::size_t vertexCount,
+                        sf::PrimitiveType type, const sf::Transform& transform, const sf::Color& color)
+    {
+        std::size_t outputCount = getListVertexCount(type, vertexCount);
+        bool modulate = (color != sf::Color::White);
+
+        for (std::size_t i = 0; i < outputCount; ++i)
+        {
+            // Find the source vertex of the i-th corner of the list
+            std::size_t index;
+            switch (type)
+            {
+                case sf::LinesStrip:     index = i / 2 + i % 2;                          break;
+                case sf::TrianglesStrip: index = i / 3 + i % 3;                          break;
+                case sf::TrianglesFan:   index = (i % 3 == 0) ? 0 : i / 3 + i % 3;       break;
+                default:                 index = i;                                      break;
+            }
+
+            output[i] = vertices[index];
+            if (modulate)
+                output[i].color = output[i].color * color;
+        }
+
+        // Then transform all the positions at once
+        transformVertices(transform, output, output, outputCount);
+    }
+
+
+    // Convert an sf::PrimitiveType constant to the corresponding OpenGL constant.
+    GLenum primitiveTypeToGlConstant(sf::PrimitiveType type)
+    {
+        // GL_QUADS is unavailable on OpenGL ES, callers must skip sf::Quads there
+        #ifdef SFML_OPENGL_ES
+            #define GL_QUADS 0
+        #endif
+
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+
+        return modes[type];
+    }
 }
 
 
@@ -82,9 +181,19 @@ namespace sf
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
-m_cache      ()
+m_cache      (),
+m_batch      ()
 {
+    {
+        Lock lock(mutex);
+        m_id = nextTargetId++;
+    }
+
     m_cache.glStatesSet = false;
+    m_batch.enabled = false;
+    m_batch.count = 0;
+    m_batch.type = Points;
+    m_batch.textureId = 0;
 }
 
 
@@ -97,7 +206,10 @@ RenderTarget::~RenderTarget()
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
-    if (activate(true))
+    // Pending batched geometry would be overwritten anyway, just drop it
+    m_batch.count = 0;
+
+    if (setTargetActive(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
@@ -111,6 +223,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending geometry must be rendered with the view it was drawn with
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -203,6 +318,112 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
+    if (m_batch.enabled)
+    {
+        // Strips and fans are unrolled to lists, so that they can be concatenated too
+        PrimitiveType listType = getListPrimitiveType(type);
+        std::size_t listCount = getListVertexCount(type, vertexCount);
+        if (listCount == 0)
+            return;
+
+        // Flush the pending geometry if it doesn't share the same render states
+        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+        if ((m_batch.count > 0) && ((listType != m_batch.type) ||
+                                    (textureId != m_batch.textureId) ||
+                                    (states.blendMode != m_batch.states.blendMode) ||
+                                    (states.shader != m_batch.states.shader)))
+            flush();
+
+        if (m_batch.count == 0)
+        {
+            m_batch.type = listType;
+            m_batch.textureId = textureId;
+            m_batch.states = RenderStates(states.blendMode, Transform::Identity, states.texture, states.shader);
+        }
+
+        // Grow the storage if needed; it is never shrunk, so that it reaches a steady size after a few frames
+        if (m_batch.count + listCount > m_batch.vertices.size())
+            m_batch.vertices.resize(m_batch.count + listCount);
+
+        // Pre-transform the vertices and append them to the batch
+        unrollVertices(&m_batch.vertices[m_batch.count], vertices, vertexCount, type, states.transform, Color::White);
+
+        m_batch.count += listCount;
+        return;
+    }
+
+    drawPrimitives(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                 const Instance* instances, std::size_t instanceCount,
+                                 const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !instances || (instanceCount == 0))
+        return;
+
+    std::size_t listCount = getListVertexCount(type, vertexCount);
+    if (listCount == 0)
+        return;
+
+    // There is no hardware instancing path: the fixed-function pipeline has no way
+    // to consume per-instance attributes (that would require ARB_instanced_arrays
+    // and a built-in shader, neither of which the GL loader provides), so instances
+    // are expanded into a single list of pre-transformed primitives
+    std::size_t totalCount = listCount * instanceCount;
+    if (totalCount > m_instanceVertices.size())
+        m_instanceVertices.resize(totalCount);
+
+    for (std::size_t i = 0; i < instanceCount; ++i)
+    {
+        Transform transform = states.transform * instances[i].transform;
+        unrollVertices(&m_instanceVertices[i * listCount], vertices, vertexCount, type, transform, instances[i].color);
+    }
+
+    // Draw all the instances with a single call
+    RenderStates instanceStates(states.blendMode, Transform::Identity, states.texture, states.shader);
+    draw(&m_instanceVertices[0], totalCount, getListPrimitiveType(type), instanceStates);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batch.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_batch.count == 0)
+        return;
+
+    // Reset the count first, so that the functions called while drawing see an empty batch
+    std::size_t count = m_batch.count;
+    m_batch.count = 0;
+
+    drawPrimitives(&m_batch.vertices[0], count, m_batch.type, m_batch.states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(const Vertex* vertices, std::size_t vertexCount,
+                                  PrimitiveType type, const RenderStates& states)
+{
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
@@ -210,10 +431,9 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
             return;
         }
-        #define GL_QUADS 0
     #endif
 
-    if (activate(true))
+    if (setTargetActive(true))
     {
         // First set the persistent OpenGL states if it's the very first call
         if (!m_cache.glStatesSet)
@@ -224,13 +444,8 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            std::copy(vertices, vertices + vertexCount, m_cache.vertexCache);
+            transformVertices(states.transform, m_cache.vertexCache, m_cache.vertexCache, vertexCount);
 
             // Since vertices are transformed, we must use an identity transform to render them
             if (!m_cache.useVertexCache)
@@ -241,22 +456,8 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             applyTransform(states.transform);
         }
 
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
-
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
-
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
-
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
+        // Apply the view, blend mode, texture and shader
+        setupDraw(states);
 
         // If we pre-transform the vertices, we must use our internal vertex cache
         if (useVertexCache)
@@ -277,22 +478,11 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
         }
 
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
-
         // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
-
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
+        glCheck(glDrawArrays(primitiveTypeToGlConstant(type), 0, vertexCount));
 
-        // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
-        // This prevents a bug where some drivers do not clear RenderTextures properly.
-        if (states.texture && states.texture->m_fboAttachment)
-            applyTexture(NULL);
+        // Unbind the shader and the render-texture's texture, if any
+        cleanupDraw(states);
 
         // Update the cache
         m_cache.useVertexCache = useVertexCache;
@@ -300,10 +490,87 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount || !vertexBuffer.getNativeHandle())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Keep the drawing order
+    flush();
+
+    if (setTargetActive(true))
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // The vertices live in graphics memory, they can't be pre-transformed
+        applyTransform(states.transform);
+
+        // Apply the view, blend mode, texture and shader
+        setupDraw(states);
+
+        // Bind the vertex buffer, the pointers become offsets into it
+        VertexBuffer::bind(&vertexBuffer);
+
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+        // Draw the primitives
+        glCheck(glDrawArrays(primitiveTypeToGlConstant(vertexBuffer.getPrimitiveType()), static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+
+        // Unbind the vertex buffer so that regular draws use client-side arrays again
+        VertexBuffer::bind(NULL);
+
+        // Unbind the shader and the render-texture's texture, if any
+        cleanupDraw(states);
+
+        // The pointers now refer to the vertex buffer, they must be set again on the next draw
+        m_cache.useVertexCache = false;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
-    if (activate(true))
+    flush();
+
+    if (setTargetActive(true))
     {
         #ifdef SFML_DEBUG
             // make sure that the user didn't leave an unchecked OpenGL error
@@ -335,7 +602,9 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
-    if (activate(true))
+    flush();
+
+    if (setTargetActive(true))
     {
         glCheck(glMatrixMode(GL_PROJECTION));
         glCheck(glPopMatrix());
@@ -354,10 +623,12 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
-    // Check here to make sure a context change does not happen after activate(true)
+    flush();
+
+    // Check here to make sure a context change does not happen after setTargetActive(true)
     bool shaderAvailable = Shader::isAvailable();
 
-    if (activate(true))
+    if (setTargetActive(true))
     {
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
@@ -406,6 +677,106 @@ void RenderTarget::initialize()
 
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
+
+    // Forget any geometry batched for a previous incarnation of the target
+    m_batch.count = 0;
+
+    // The frame buffer of the target may have changed, it must be bound again
+    Lock lock(mutex);
+    for (std::map<Uint64, Uint64>::iterator it = contextTargets.begin(); it != contextTargets.end(); )
+    {
+        if (it->second == m_id)
+            contextTargets.erase(it++);
+        else
+            ++it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::setTargetActive(bool active)
+{
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (active)
+    {
+        // Nothing to do if the target is already the active one in the current context
+        if (contextId)
+        {
+            Lock lock(mutex);
+            std::map<Uint64, Uint64>::const_iterator it = contextTargets.find(contextId);
+            if ((it != contextTargets.end()) && (it->second == m_id))
+                return true;
+        }
+
+        if (!activate(true))
+            return false;
+
+        // Activating the target may have made another context current
+        contextId = Context::getActiveContextId();
+
+        Lock lock(mutex);
+        Uint64& target = contextTargets[contextId];
+        if (target != m_id)
+        {
+            // Another target may have changed the states of the context
+            target = m_id;
+            m_cache.glStatesSet = false;
+        }
+
+        return true;
+    }
+    else
+    {
+        // The pending geometry must be rendered while the target can still be drawn to
+        flush();
+        contextId = Context::getActiveContextId();
+
+        {
+            Lock lock(mutex);
+            std::map<Uint64, Uint64>::iterator it = contextTargets.find(contextId);
+            if ((it != contextTargets.end()) && (it->second == m_id))
+                contextTargets.erase(it);
+        }
+
+        return activate(false);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(const RenderStates& states)
+{
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (textureId != m_cache.lastTextureId)
+        applyTexture(states.texture);
+
+    // Apply the shader
+    if (states.shader)
+        applyShader(states.shader);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupDraw(const RenderStates& states)
+{
+    // Unbind the shader, if any
+    if (states.shader)
+        applyShader(NULL);
+
+    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
+    // This prevents a bug where some drivers do not clear RenderTextures properly.
+    if (states.texture && states.texture->m_fboAttachment)
+        applyTexture(NULL);
 }
 
 
@@ -538,4 +909,22 @@ void RenderTarget::applyShader(const Shader* shader)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Batching
+//   When enabled, draw calls that share the same texture, blend
+//   mode and shader are pre-transformed on the CPU and appended
+//   to a single vertex buffer, which is sent with one draw call
+//   when any of these states (or the view) changes. Strips and
+//   fans are unrolled to the equivalent lists so that they can
+//   be concatenated. The buffer is never shrunk, so that it
+//   stops reallocating after the first frames.
+//
+// * Instancing
+//   Instanced draws are expanded on the CPU the same way (one
+//   unrolled copy of the geometry per instance) and sent with a
+//   single draw call, or appended to the batch. This is a
+//   deliberate fallback rather than glDrawArraysInstanced:
+//   per-instance transforms and colors can only be consumed by
+//   a vertex shader, and the renderer must keep working with
+//   the plain fixed-function pipeline and any user shader.
+//
 ////////////////////////////////////////////////////////////
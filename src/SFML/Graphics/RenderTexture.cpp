@@ -119,18 +119,28 @@ bool RenderTexture::isRepeated() const
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
-    return m_impl && m_impl->activate(active);
+    return m_impl && setTargetActive(active);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Render what is left in the batch
+    flush();
+
     // Update the target texture
     if (setActive(true))
     {
         m_impl->updateTexture(m_texture.m_texture);
         m_texture.m_pixelsFlipped = true;
+
+        // An FBO render texture renders in the current context, which may
+        // belong to a window that the caller renders to with OpenGL: give
+        // it its default frame buffer back. This only changes a binding,
+        // unlike the default implementation which would switch contexts
+        if (m_texture.m_fboAttachment)
+            setActive(false);
     }
 }
 
@@ -152,7 +162,7 @@ const Texture& RenderTexture::getTexture() const
 ////////////////////////////////////////////////////////////
 bool RenderTexture::activate(bool active)
 {
-    return setActive(active);
+    return m_impl && m_impl->activate(active);
 }
 
 } // namespace sf
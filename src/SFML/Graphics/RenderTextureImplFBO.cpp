@@ -28,7 +28,21 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <vector>
+
+
+namespace
+{
+    // Frame buffer objects can only be deleted in the context that created
+    // them; those of destroyed render textures wait here, per context, until
+    // their context is active again
+    sf::Mutex mutex;
+    std::map<sf::Uint64, std::vector<unsigned int> > staleFrameBuffers;
+}
 
 
 namespace sf
@@ -37,8 +51,9 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::RenderTextureImplFBO() :
-m_frameBuffer(0),
-m_depthBuffer(0)
+m_frameBuffers(),
+m_depthBuffer (0),
+m_textureId   (0)
 {
 
 }
@@ -49,22 +64,30 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
 {
     ensureGlContext();
 
-    // Destroy the depth buffer
+    // Destroy the depth buffer (render buffers are shared by all the contexts)
     if (m_depthBuffer)
     {
         GLuint depthBuffer = static_cast<GLuint>(m_depthBuffer);
         glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
     }
 
-    // Destroy the frame buffer
-    if (m_frameBuffer)
+    // Destroy the frame buffer of the current context; the frame buffers
+    // of the other contexts are deleted the next time a render texture or
+    // a render window is activated in them
+    Uint64 contextId = Context::getActiveContextId();
+    for (FrameBufferTable::iterator it = m_frameBuffers.begin(); it != m_frameBuffers.end(); ++it)
     {
-        GLuint frameBuffer = static_cast<GLuint>(m_frameBuffer);
-        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        if (it->first == contextId)
+        {
+            GLuint frameBuffer = static_cast<GLuint>(it->second);
+            glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        }
+        else
+        {
+            Lock lock(mutex);
+            staleFrameBuffers[it->first].push_back(it->second);
+        }
     }
-
-    // Delete the context
-    delete m_context;
 }
 
 
@@ -81,21 +104,48 @@ bool RenderTextureImplFBO::isAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
+void RenderTextureImplFBO::unbind()
 {
-    // Create the context
-    m_context = new Context;
+    deleteStaleFrameBuffers();
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::deleteStaleFrameBuffers()
+{
+    std::vector<unsigned int> frameBuffers;
 
-    // Create the framebuffer object
-    GLuint frameBuffer = 0;
-    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
-    m_frameBuffer = static_cast<unsigned int>(frameBuffer);
-    if (!m_frameBuffer)
     {
-        err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
-        return false;
+        Lock lock(mutex);
+
+        if (staleFrameBuffers.empty())
+            return;
+
+        std::map<Uint64, std::vector<unsigned int> >::iterator it = staleFrameBuffers.find(Context::getActiveContextId());
+        if (it == staleFrameBuffers.end())
+            return;
+
+        frameBuffers.swap(it->second);
+        staleFrameBuffers.erase(it);
     }
-    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
+
+    for (std::vector<unsigned int>::const_iterator it = frameBuffers.begin(); it != frameBuffers.end(); ++it)
+    {
+        GLuint frameBuffer = static_cast<GLuint>(*it);
+        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
+{
+    // Use the context which is active on this thread, or the internal one of the thread
+    ensureGlContext();
+
+    m_textureId = textureId;
 
     // Create the depth buffer if requested
     if (depthBuffer)
@@ -110,22 +160,50 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         }
         glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
         glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
-        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
     }
 
+    // Create the frame buffer of the current context now, so that errors are reported early
+    return createFrameBuffer(Context::getActiveContextId());
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::createFrameBuffer(Uint64 contextId)
+{
+    // Create the framebuffer object
+    GLuint frameBuffer = 0;
+    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+    if (!frameBuffer)
+    {
+        err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
+        return false;
+    }
+
+    // The frame buffer may be created while another one is in use, preserve it
+    GLint previousFrameBuffer;
+    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+
+    // Attach the depth buffer, if any
+    if (m_depthBuffer)
+        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+
     // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0));
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
 
     // A final check, just to be sure...
     GLenum status;
     glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
     if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
     {
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
         err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
         return false;
     }
 
+    m_frameBuffers[contextId] = static_cast<unsigned int>(frameBuffer);
+
     return true;
 }
 
@@ -133,14 +211,41 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplFBO::activate(bool active)
 {
-    return m_context->setActive(active);
+    if (!active)
+    {
+        unbind();
+        return true;
+    }
+
+    // Render with the context which is active on this thread, or the internal one of the thread
+    ensureGlContext();
+
+    // Take the opportunity to release what other render textures left in this context
+    deleteStaleFrameBuffers();
+
+    Uint64 contextId = Context::getActiveContextId();
+    FrameBufferTable::const_iterator it = m_frameBuffers.find(contextId);
+    if (it == m_frameBuffers.end())
+    {
+        // First use of the render texture in this context
+        if (!createFrameBuffer(contextId))
+            return false;
+
+        it = m_frameBuffers.find(contextId);
+    }
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second));
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::updateTexture(unsigned int)
 {
-    glCheck(glFlush());
+    // Nothing to do: the frame buffer renders directly to the texture.
+    // The commands are not flushed, the contexts of the same thread see
+    // them anyway and those of other threads need a stronger guarantee
 }
 
 } // namespace priv
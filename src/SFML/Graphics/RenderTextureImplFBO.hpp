@@ -29,8 +29,8 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTextureImpl.hpp>
-#include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <map>
 
 
 namespace sf
@@ -66,8 +66,45 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the default frame buffer in the current context
+    ///
+    /// Render textures bind their frame buffer in the context which
+    /// is active when they are activated, which may be the context
+    /// of a window; the window calls this function to draw to its
+    /// own frame buffer again.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unbind();
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the frame buffers that destroyed render
+    ///        textures left in the current context
+    ///
+    /// A render texture can only delete the frame buffer of the
+    /// context which is active when it is destroyed; the others
+    /// are queued and deleted when their context is active again.
+    /// The frame buffers of contexts that are destroyed before
+    /// that are released along with the context.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deleteStaleFrameBuffers();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the frame buffer object of the current context
+    ///
+    /// Frame buffer objects cannot be shared between contexts, so
+    /// a render texture creates one in each context it is used in.
+    ///
+    /// \param contextId Identifier of the current context
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createFrameBuffer(Uint64 contextId);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
@@ -102,9 +139,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Context*     m_context;     ///< Needs a separate OpenGL context for not messing up the other ones
-    unsigned int m_frameBuffer; ///< OpenGL frame buffer object
-    unsigned int m_depthBuffer; ///< Optional depth buffer attached to the frame buffer
+    typedef std::map<Uint64, unsigned int> FrameBufferTable;
+
+    FrameBufferTable m_frameBuffers; ///< OpenGL frame buffer objects, one per context the texture was used in
+    unsigned int     m_depthBuffer;  ///< Optional depth buffer attached to the frame buffers
+    unsigned int     m_textureId;    ///< OpenGL identifier of the target texture
 };
 
 } // namespace priv
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_available(),
+m_acquired ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    clear();
+
+    for (EntryArray::iterator it = m_acquired.begin(); it != m_acquired.end(); ++it)
+        delete it->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, bool depthBuffer)
+{
+    // Reuse a released render texture with the same size and format
+    for (EntryArray::iterator it = m_available.begin(); it != m_available.end(); ++it)
+    {
+        Vector2u size = it->texture->getSize();
+        if ((size.x == width) && (size.y == height) && (it->depthBuffer == depthBuffer))
+        {
+            Entry entry = *it;
+            m_available.erase(it);
+            m_acquired.push_back(entry);
+
+            // Restore the states of a newly created render texture
+            entry.texture->setView(entry.texture->getDefaultView());
+            entry.texture->setSmooth(false);
+            entry.texture->setRepeated(false);
+
+            return entry.texture;
+        }
+    }
+
+    // None available, create a new one
+    Entry entry;
+    entry.texture = new RenderTexture;
+    entry.depthBuffer = depthBuffer;
+    if (!entry.texture->create(width, height, depthBuffer))
+    {
+        delete entry.texture;
+        return NULL;
+    }
+
+    m_acquired.push_back(entry);
+
+    return entry.texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* texture)
+{
+    for (EntryArray::iterator it = m_acquired.begin(); it != m_acquired.end(); ++it)
+    {
+        if (it->texture == texture)
+        {
+            m_available.push_back(*it);
+            m_acquired.erase(it);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::clear()
+{
+    for (EntryArray::iterator it = m_available.begin(); it != m_available.end(); ++it)
+        delete it->texture;
+
+    m_available.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getAvailableCount() const
+{
+    return m_available.size();
+}
+
+} // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 
 
@@ -64,7 +65,15 @@ RenderWindow::~RenderWindow()
 ////////////////////////////////////////////////////////////
 bool RenderWindow::activate(bool active)
 {
-    return setActive(active);
+    if (!setActive(active))
+        return false;
+
+    // Render textures may have bound their frame buffer in the context
+    // of the window, make sure that we draw to the window itself
+    if (active && priv::RenderTextureImplFBO::isAvailable())
+        priv::RenderTextureImplFBO::unbind();
+
+    return true;
 }
 
 
@@ -78,6 +87,10 @@ Vector2u RenderWindow::getSize() const
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // Render what is left in the batch, so that it is captured too; this
+    // doesn't change the logical contents of the window
+    const_cast<RenderWindow*>(this)->flush();
+
     Image image;
     if (setActive())
     {
@@ -114,4 +127,12 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Render what is left in the batch before swapping the buffers
+    flush();
+}
+
 } // namespace sf
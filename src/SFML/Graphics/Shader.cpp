@@ -34,6 +34,7 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -141,12 +142,35 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle() :
+m_location(-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle(int location) :
+m_location(location)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::UniformHandle::isValid() const
+{
+    return m_location != -1;
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
 m_currentTexture(-1),
 m_textures      (),
-m_params        ()
+m_params        (),
+m_uniforms      (),
+m_uniformValues ()
 {
 }
 
@@ -270,194 +294,206 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& fragme
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
+    setParameter(getUniformHandle(name), x);
+}
 
-        // Enable program
-        GLEXT_GLhandle program;
-        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
 
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform1f(location, x));
-        }
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y)
+{
+    setParameter(getUniformHandle(name), x, y);
+}
 
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y, float z)
+{
+    setParameter(getUniformHandle(name), x, y, z);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y)
+void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
+    setParameter(getUniformHandle(name), x, y, z, w);
+}
 
-        // Enable program
-        GLEXT_GLhandle program;
-        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
 
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform2f(location, x, y));
-        }
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Vector2f& v)
+{
+    setParameter(getUniformHandle(name), v.x, v.y);
+}
 
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Vector3f& v)
+{
+    setParameter(getUniformHandle(name), v.x, v.y, v.z);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y, float z)
+void Shader::setParameter(const std::string& name, const Color& color)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
+    setParameter(getUniformHandle(name), color);
+}
 
-        // Enable program
-        GLEXT_GLhandle program;
-        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
 
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform3f(location, x, y, z));
-        }
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Transform& transform)
+{
+    setParameter(getUniformHandle(name), transform);
+}
 
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Texture& texture)
+{
+    setParameter(getUniformHandle(name), texture);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
+void Shader::setParameter(const std::string& name, CurrentTextureType)
+{
+    setParameter(getUniformHandle(name), CurrentTexture);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
 {
     if (m_shaderProgram)
-    {
-        ensureGlContext();
+        return UniformHandle(getParamLocation(name));
+    else
+        return UniformHandle();
+}
 
-        // Enable program
-        GLEXT_GLhandle program;
-        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
 
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform4f(location, x, y, z, w));
-        }
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, float x)
+{
+    storeUniform(handle.m_location, &x, 1, 1);
+}
 
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, float x, float y)
+{
+    float values[2] = {x, y};
+    storeUniform(handle.m_location, values, 2, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Vector2f& v)
+void Shader::setParameter(UniformHandle handle, float x, float y, float z)
 {
-    setParameter(name, v.x, v.y);
+    float values[3] = {x, y, z};
+    storeUniform(handle.m_location, values, 3, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Vector3f& v)
+void Shader::setParameter(UniformHandle handle, float x, float y, float z, float w)
 {
-    setParameter(name, v.x, v.y, v.z);
+    float values[4] = {x, y, z, w};
+    storeUniform(handle.m_location, values, 4, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Color& color)
+void Shader::setParameter(UniformHandle handle, const Vector2f& v)
 {
-    setParameter(name, color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
+    setParameter(handle, v.x, v.y);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Transform& transform)
+void Shader::setParameter(UniformHandle handle, const Vector3f& v)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
+    setParameter(handle, v.x, v.y, v.z);
+}
 
-        // Enable program
-        GLEXT_GLhandle program;
-        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
 
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniformMatrix4fv(location, 1, GL_FALSE, transform.getMatrix()));
-        }
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Color& color)
+{
+    setParameter(handle, color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
+}
 
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Transform& transform)
+{
+    storeUniform(handle.m_location, transform.getMatrix(), 16, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Texture& texture)
+void Shader::setParameter(UniformHandle handle, const Texture& texture)
 {
-    if (m_shaderProgram)
+    if (m_shaderProgram && (handle.m_location != -1))
     {
-        ensureGlContext();
-
-        // Find the location of the variable in the shader
-        int location = getParamLocation(name);
-        if (location != -1)
+        // Store the location -> texture mapping
+        TextureTable::iterator it = m_textures.find(handle.m_location);
+        if (it == m_textures.end())
         {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
-            {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
-                {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
-                }
-
-                m_textures[location] = &texture;
-            }
-            else
+            ensureGlContext();
+
+            // New entry, make sure there are enough texture units
+            GLint maxUnits = getMaxTextureUnits();
+            if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
             {
-                // Location already used, just replace the texture
-                it->second = &texture;
+                err() << "Impossible to use texture for shader: all available texture units are used" << std::endl;
+                return;
             }
+
+            m_textures[handle.m_location] = &texture;
+        }
+        else
+        {
+            // Location already used, just replace the texture
+            it->second = &texture;
         }
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, CurrentTextureType)
+void Shader::setParameter(UniformHandle handle, CurrentTextureType)
 {
     if (m_shaderProgram)
-    {
-        ensureGlContext();
+        m_currentTexture = handle.m_location;
+}
 
-        // Find the location of the variable in the shader
-        m_currentTexture = getParamLocation(name);
+
+////////////////////////////////////////////////////////////
+void Shader::setParameterArray(UniformHandle handle, const float* values, std::size_t length, unsigned int components)
+{
+    if ((components < 1) || (components > 4))
+    {
+        err() << "Failed to set shader parameter array: elements must have 1 to 4 components" << std::endl;
+        return;
     }
+
+    if (values && (length > 0))
+        storeUniform(handle.m_location, values, components, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameterArray(UniformHandle handle, const Transform* transforms, std::size_t length)
+{
+    if (!m_shaderProgram || (handle.m_location == -1) || !transforms || (length == 0))
+        return;
+
+    // Gather the matrices in a contiguous array, then store them all at once
+    std::vector<float> matrices(length * 16);
+    for (std::size_t i = 0; i < length; ++i)
+        std::copy(transforms[i].getMatrix(), transforms[i].getMatrix() + 16, &matrices[i * 16]);
+
+    storeUniform(handle.m_location, &matrices[0], 16, length);
 }
 
 
@@ -486,6 +522,9 @@ void Shader::bind(const Shader* shader)
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
 
+        // Send the parameters changed since the last time the shader was bound
+        shader->applyUniforms();
+
         // Bind the textures
         shader->bindTextures();
 
@@ -537,6 +576,8 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
     m_currentTexture = -1;
     m_textures.clear();
     m_params.clear();
+    m_uniforms.clear();
+    m_uniformValues.clear();
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
@@ -642,6 +683,65 @@ void Shader::bindTextures() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::storeUniform(int location, const float* values, unsigned int components, std::size_t length)
+{
+    if (!m_shaderProgram || (location == -1))
+        return;
+
+    std::size_t size = components * length;
+
+    // Overwrite the value already waiting for this location, if any
+    for (UniformTable::iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+    {
+        if (it->location == location)
+        {
+            if ((it->components == components) && (it->length == length))
+            {
+                std::copy(values, values + size, &m_uniformValues[it->offset]);
+                return;
+            }
+
+            // The size changed: drop the old value, the new one is appended below
+            m_uniforms.erase(it);
+            break;
+        }
+    }
+
+    UniformValue uniform;
+    uniform.location = location;
+    uniform.components = components;
+    uniform.length = length;
+    uniform.offset = m_uniformValues.size();
+    m_uniforms.push_back(uniform);
+
+    m_uniformValues.insert(m_uniformValues.end(), values, values + size);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::applyUniforms() const
+{
+    for (UniformTable::const_iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+    {
+        const GLfloat* values = &m_uniformValues[it->offset];
+        GLsizei length = static_cast<GLsizei>(it->length);
+
+        switch (it->components)
+        {
+            case 1:  glCheck(GLEXT_glUniform1fv(it->location, length, values)); break;
+            case 2:  glCheck(GLEXT_glUniform2fv(it->location, length, values)); break;
+            case 3:  glCheck(GLEXT_glUniform3fv(it->location, length, values)); break;
+            case 4:  glCheck(GLEXT_glUniform4fv(it->location, length, values)); break;
+            case 16: glCheck(GLEXT_glUniformMatrix4fv(it->location, length, GL_FALSE, values)); break;
+        }
+    }
+
+    m_uniforms.clear();
+    m_uniformValues.clear();
+}
+
+
 ////////////////////////////////////////////////////////////
 int Shader::getParamLocation(const std::string& name)
 {
@@ -654,6 +754,8 @@ int Shader::getParamLocation(const std::string& name)
     }
     else
     {
+        ensureGlContext();
+
         // Not in cache, request the location from OpenGL
         int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
         m_params.insert(std::make_pair(name, location));
@@ -677,6 +779,27 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle() :
+m_location(-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle(int location) :
+m_location(location)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::UniformHandle::isValid() const
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
@@ -793,6 +916,85 @@ void Shader::setParameter(const std::string& name, CurrentTextureType)
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return UniformHandle();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, float x, float y)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, float x, float y, float z)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, float x, float y, float z, float w)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Vector2f& vector)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Vector3f& vector)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Color& color)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Transform& transform)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, const Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(UniformHandle handle, CurrentTextureType)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameterArray(UniformHandle handle, const float* values, std::size_t length, unsigned int components)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameterArray(UniformHandle handle, const Transform* transforms, std::size_t length)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
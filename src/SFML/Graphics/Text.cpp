@@ -28,9 +28,49 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 #include <cmath>
 
 
+namespace
+{
+    // Add an underline or strikethrough line to the vertex array
+    void addLine(std::vector<sf::Vertex>& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness)
+    {
+        float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+        float bottom = top + std::floor(thickness + 0.5f);
+
+        vertices.push_back(sf::Vertex(sf::Vector2f(0, top),             color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength, top),    color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(0, bottom),          color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(0, bottom),          color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength, top),    color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength, bottom), color, sf::Vector2f(1, 1)));
+    }
+
+    // Add a glyph quad to the vertex array
+    void addGlyphQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italic)
+    {
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italic * top,    position.y + top),    color, sf::Vector2f(u1, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italic * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italic * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italic * bottom, position.y + bottom), color, sf::Vector2f(u2, v2)));
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -40,8 +80,9 @@ m_font              (NULL),
 m_characterSize     (30),
 m_style             (Regular),
 m_color             (255, 255, 255),
-m_vertices          (Triangles),
+m_vertices          (),
 m_bounds            (),
+m_layout            (),
 m_geometryNeedUpdate(false)
 {
 
@@ -55,8 +96,9 @@ m_font              (&font),
 m_characterSize     (characterSize),
 m_style             (Regular),
 m_color             (255, 255, 255),
-m_vertices          (Triangles),
+m_vertices          (),
 m_bounds            (),
+m_layout            (),
 m_geometryNeedUpdate(true)
 {
 
@@ -68,8 +110,14 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // If characters are only appended, the current geometry can be kept and
+        // completed; otherwise it must be rebuilt
+        bool appended = !m_string.isEmpty() && (string.getSize() > m_string.getSize()) &&
+                        std::equal(m_string.begin(), m_string.end(), string.begin());
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        if (!appended)
+            m_geometryNeedUpdate = true;
     }
 }
 
@@ -118,7 +166,7 @@ void Text::setColor(const Color& color)
         // (if geometry is updated anyway, we can skip this step)
         if (!m_geometryNeedUpdate)
         {
-            for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
                 m_vertices[i].color = m_color;
         }
     }
@@ -231,7 +279,8 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
-        target.draw(m_vertices, states);
+        if (!m_vertices.empty())
+            target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
     }
 }
 
@@ -239,25 +288,47 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
-    // Do nothing, if geometry has not changed
-    if (!m_geometryNeedUpdate)
+    // Do nothing, if geometry has not changed and no character was appended
+    if (!m_geometryNeedUpdate && (m_layout.length == m_string.getSize()))
         return;
 
-    // Mark geometry as updated
-    m_geometryNeedUpdate = false;
-
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = FloatRect();
+    // Restart from scratch if anything else than the end of the string changed
+    if (m_geometryNeedUpdate)
+    {
+        // Mark geometry as updated
+        m_geometryNeedUpdate = false;
+
+        // Clear the previous geometry (the memory is kept for the new one)
+        m_vertices.clear();
+        m_bounds = FloatRect();
+        m_layout.length      = 0;
+        m_layout.vertexCount = 0;
+        m_layout.position    = Vector2f(0.f, static_cast<float>(m_characterSize));
+        m_layout.min         = Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize));
+        m_layout.max         = Vector2f(0.f, 0.f);
+        m_layout.lastChar    = 0;
+    }
 
     // No font: nothing to draw
     if (!m_font)
+    {
+        m_layout.length = m_string.getSize();
         return;
+    }
 
     // No text: nothing to draw
     if (m_string.isEmpty())
         return;
 
+    // Remove the lines of the last row, they will be added again with the new characters
+    m_vertices.resize(m_layout.vertexCount);
+
+    // Make room for the new quads, with an exponential growth so that
+    // appending a few characters at a time stays cheap
+    std::size_t required = m_vertices.size() + (m_string.getSize() - m_layout.length) * 6 + 12;
+    if (required > m_vertices.capacity())
+        m_vertices.reserve(std::max(required, m_vertices.capacity() * 2));
+
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
     bool  underlined         = (m_style & Underlined) != 0;
@@ -275,16 +346,18 @@ void Text::ensureGeometryUpdate() const
     // Precompute the variables needed by the algorithm
     float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
     float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
-
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+
+    // Resume the layout where it was left
+    float x = m_layout.position.x;
+    float y = m_layout.position.y;
+    float minX = m_layout.min.x;
+    float minY = m_layout.min.y;
+    float maxX = m_layout.max.x;
+    float maxY = m_layout.max.y;
+    Uint32 prevChar = m_layout.lastChar;
+
+    // Create one quad for each new character
+    for (std::size_t i = m_layout.length; i < m_string.getSize(); ++i)
     {
         Uint32 curChar = m_string[i];
 
@@ -294,31 +367,11 @@ void Text::ensureGeometryUpdate() const
 
         // If we're using the underlined style and there's a new line, draw a line
         if (underlined && (curChar == L'\n'))
-        {
-            float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+            addLine(m_vertices, x, y, m_color, underlineOffset, underlineThickness);
 
         // If we're using the strike through style and there's a new line, draw a line across all characters
         if (strikeThrough && (curChar == L'\n'))
-        {
-            float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+            addLine(m_vertices, x, y, m_color, strikeThroughOffset, underlineThickness);
 
         // Handle special characters
         if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
@@ -350,18 +403,8 @@ void Text::ensureGeometryUpdate() const
         float right  = glyph.bounds.left + glyph.bounds.width;
         float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-        float u1 = static_cast<float>(glyph.textureRect.left);
-        float v1 = static_cast<float>(glyph.textureRect.top);
-        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
-        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
-
         // Add a quad for the current character
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
+        addGlyphQuad(m_vertices, Vector2f(x, y), m_color, glyph, italic);
 
         // Update the current bounds
         minX = std::min(minX, x + left - italic * bottom);
@@ -373,33 +416,21 @@ void Text::ensureGeometryUpdate() const
         x += glyph.advance;
     }
 
+    // Save the layout state, so that characters appended later can continue from here
+    m_layout.length      = m_string.getSize();
+    m_layout.vertexCount = m_vertices.size();
+    m_layout.position    = Vector2f(x, y);
+    m_layout.min         = Vector2f(minX, minY);
+    m_layout.max         = Vector2f(maxX, maxY);
+    m_layout.lastChar    = prevChar;
+
     // If we're using the underlined style, add the last line
     if (underlined)
-    {
-        float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-    }
+        addLine(m_vertices, x, y, m_color, underlineOffset, underlineThickness);
 
     // If we're using the strike through style, add the last line across all characters
     if (strikeThrough)
-    {
-        float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-    }
+        addLine(m_vertices, x, y, m_color, strikeThroughOffset, underlineThickness);
 
     // Update the bounding rectangle
     m_bounds.left = minX;
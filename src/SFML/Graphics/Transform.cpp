@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/TransformPoints.hpp>
 #include <cmath>
 
 
@@ -109,6 +110,16 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const
+{
+    if (!points || !result || (count == 0))
+        return;
+
+    priv::transformPoints(m_matrix, &points[0].x, 2, &result[0].x, 2, count);
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
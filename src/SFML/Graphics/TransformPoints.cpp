@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TransformPoints.hpp>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+
+    // GCC and Clang: the SSE2 kernel is compiled for SSE2 even if the
+    // rest of the library isn't, and selected at runtime on 32-bit x86
+    #define SFML_TRANSFORM_SSE2
+    #define SFML_TRANSFORM_SSE2_TARGET __attribute__((target("sse2")))
+    #include <emmintrin.h>
+    #if defined(__i386__)
+        #include <cpuid.h>
+    #endif
+
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+
+    #define SFML_TRANSFORM_SSE2
+    #define SFML_TRANSFORM_SSE2_TARGET
+    #include <emmintrin.h>
+    #if defined(_M_IX86)
+        #include <intrin.h>
+    #endif
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    // NEON availability is known at compile time
+    #define SFML_TRANSFORM_NEON
+    #include <arm_neon.h>
+
+#endif
+
+
+namespace
+{
+    typedef void (*TransformKernel)(const float*, const float*, std::size_t, float*, std::size_t, std::size_t);
+
+    // Portable version: x' = m0 * x + m4 * y + m12, y' = m1 * x + m5 * y + m13
+    void transformPointsScalar(const float* matrix, const float* input, std::size_t inputStride,
+                               float* output, std::size_t outputStride, std::size_t count)
+    {
+        const float a = matrix[0], b = matrix[4], c = matrix[12];
+        const float d = matrix[1], e = matrix[5], f = matrix[13];
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float x = input[0];
+            float y = input[1];
+            output[0] = a * x + b * y + c;
+            output[1] = d * x + e * y + f;
+
+            input += inputStride;
+            output += outputStride;
+        }
+    }
+
+#if defined(SFML_TRANSFORM_SSE2)
+
+    // SSE2 version: two points are packed in a register and transformed at once
+    SFML_TRANSFORM_SSE2_TARGET
+    void transformPointsSse2(const float* matrix, const float* input, std::size_t inputStride,
+                             float* output, std::size_t outputStride, std::size_t count)
+    {
+        const __m128 xColumn = _mm_setr_ps(matrix[0],  matrix[1],  matrix[0],  matrix[1]);
+        const __m128 yColumn = _mm_setr_ps(matrix[4],  matrix[5],  matrix[4],  matrix[5]);
+        const __m128 offset  = _mm_setr_ps(matrix[12], matrix[13], matrix[12], matrix[13]);
+
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            // Load (x0, y0, x1, y1); both points are read before anything is written,
+            // which makes in-place transformations safe
+            __m128 points = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(input));
+            points = _mm_loadh_pi(points, reinterpret_cast<const __m64*>(input + inputStride));
+
+            // Broadcast to (x0, x0, x1, x1) and (y0, y0, y1, y1)
+            __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, xColumn), _mm_mul_ps(y, yColumn)), offset);
+
+            _mm_storel_pi(reinterpret_cast<__m64*>(output), result);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(output + outputStride), result);
+
+            input += 2 * inputStride;
+            output += 2 * outputStride;
+        }
+
+        // Odd point left
+        if (i < count)
+            transformPointsScalar(matrix, input, inputStride, output, outputStride, 1);
+    }
+
+    bool checkSse2Support()
+    {
+    #if defined(__x86_64__) || defined(_M_X64)
+        // SSE2 is part of the x86-64 baseline
+        return true;
+    #elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+    #else
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (edx & bit_SSE2) != 0;
+    #endif
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    // NEON version: one point per 64-bit register, two multiply-accumulates
+    void transformPointsNeon(const float* matrix, const float* input, std::size_t inputStride,
+                             float* output, std::size_t outputStride, std::size_t count)
+    {
+        const float xValues[2] = {matrix[0],  matrix[1]};
+        const float yValues[2] = {matrix[4],  matrix[5]};
+        const float offsets[2] = {matrix[12], matrix[13]};
+        const float32x2_t xColumn = vld1_f32(xValues);
+        const float32x2_t yColumn = vld1_f32(yValues);
+        const float32x2_t offset  = vld1_f32(offsets);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float32x2_t point = vld1_f32(input);
+            float32x2_t result = vmla_lane_f32(vmla_lane_f32(offset, xColumn, point, 0), yColumn, point, 1);
+            vst1_f32(output, result);
+
+            input += inputStride;
+            output += outputStride;
+        }
+    }
+
+#endif
+
+    TransformKernel selectKernel()
+    {
+    #if defined(SFML_TRANSFORM_SSE2)
+        if (checkSse2Support())
+            return &transformPointsSse2;
+    #elif defined(SFML_TRANSFORM_NEON)
+        return &transformPointsNeon;
+    #endif
+
+        return &transformPointsScalar;
+    }
+
+    void selectAndTransform(const float* matrix, const float* input, std::size_t inputStride,
+                            float* output, std::size_t outputStride, std::size_t count);
+
+    // Kernel called by transformPoints; it is initialized with a constant,
+    // so that it is valid even when transformPoints is called from a static
+    // initializer in another file, and replaced by the best kernel on first
+    // use. Concurrent first calls all store the same value.
+    TransformKernel kernel = &selectAndTransform;
+
+    void selectAndTransform(const float* matrix, const float* input, std::size_t inputStride,
+                            float* output, std::size_t outputStride, std::size_t count)
+    {
+        kernel = selectKernel();
+        kernel(matrix, input, inputStride, output, outputStride, count);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void transformPoints(const float* matrix, const float* input, std::size_t inputStride,
+                     float* output, std::size_t outputStride, std::size_t count)
+{
+    kernel(matrix, input, inputStride, output, outputStride, count);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TRANSFORMPOINTS_HPP
+#define SFML_TRANSFORMPOINTS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Transform an array of 2D points by a 4x4 matrix
+///
+/// Points are read as two consecutive floats (x, y) every
+/// \a inputStride floats, and written every \a outputStride
+/// floats; this allows transforming the positions of sf::Vertex
+/// arrays in place. The best kernel available on the running
+/// CPU (SSE2, NEON or scalar) is selected on first use.
+///
+/// \param matrix       Column-major 4x4 matrix (see Transform::getMatrix)
+/// \param input        Pointer to the first input point
+/// \param inputStride  Distance between two input points, in floats
+/// \param output       Pointer to the first output point (can be equal to \a input)
+/// \param outputStride Distance between two output points, in floats
+/// \param count        Number of points to transform
+///
+////////////////////////////////////////////////////////////
+void transformPoints(const float* matrix, const float* input, std::size_t inputStride,
+                     float* output, std::size_t outputStride, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TRANSFORMPOINTS_HPP
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/DatagramBatch.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DatagramBatch::DatagramBatch(std::size_t capacity, std::size_t maxDatagramSize) :
+m_capacity       (capacity),
+m_maxDatagramSize(maxDatagramSize),
+m_buffer         (capacity * maxDatagramSize),
+m_packets        (capacity)
+{
+    m_datagrams.reserve(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DatagramBatch::getCapacity() const
+{
+    return m_capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DatagramBatch::getMaxDatagramSize() const
+{
+    return m_maxDatagramSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DatagramBatch::getCount() const
+{
+    return m_datagrams.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void DatagramBatch::clear()
+{
+    m_datagrams.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DatagramBatch::append(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort)
+{
+    if ((m_datagrams.size() >= m_capacity) || (size > m_maxDatagramSize))
+        return false;
+
+    if (size > 0)
+        std::memcpy(getBuffer(m_datagrams.size()), data, size);
+
+    Datagram datagram;
+    datagram.size    = size;
+    datagram.address = remoteAddress;
+    datagram.port    = remotePort;
+    m_datagrams.push_back(datagram);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DatagramBatch::append(Packet& packet, const IpAddress& remoteAddress, unsigned short remotePort)
+{
+    std::size_t size = 0;
+    const void* data = packet.onSend(size);
+
+    return append(data, size, remoteAddress, remotePort);
+}
+
+
+////////////////////////////////////////////////////////////
+const void* DatagramBatch::getData(std::size_t index) const
+{
+    if (m_buffer.empty())
+        return NULL;
+
+    return &m_buffer[index * m_maxDatagramSize];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DatagramBatch::getDataSize(std::size_t index) const
+{
+    return m_datagrams[index].size;
+}
+
+
+////////////////////////////////////////////////////////////
+const IpAddress& DatagramBatch::getRemoteAddress(std::size_t index) const
+{
+    return m_datagrams[index].address;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short DatagramBatch::getRemotePort(std::size_t index) const
+{
+    return m_datagrams[index].port;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& DatagramBatch::getPacket(std::size_t index)
+{
+    Packet& packet = m_packets[index];
+    packet.setView(getData(index), m_datagrams[index].size);
+
+    return packet;
+}
+
+
+////////////////////////////////////////////////////////////
+char* DatagramBatch::getBuffer(std::size_t index)
+{
+    return &m_buffer[index * m_maxDatagramSize];
+}
+
+} // namespace sf
@@ -29,9 +29,7 @@
 #include <SFML/System/Err.hpp>
 #include <cctype>
 #include <algorithm>
-#include <iterator>
 #include <sstream>
-#include <limits>
 
 
 namespace
@@ -43,6 +41,14 @@ namespace
             *i = static_cast<char>(std::tolower(*i));
         return str;
     }
+
+    // Skip the spaces at the beginning of a range of characters
+    const char* skipSpaces(const char* begin, const char* end)
+    {
+        while ((begin != end) && ((*begin == ' ') || (*begin == '\t')))
+            ++begin;
+        return begin;
+    }
 }
 
 
@@ -196,117 +202,75 @@ const std::string& Http::Response::getBody() const
 
 
 ////////////////////////////////////////////////////////////
-void Http::Response::parse(const std::string& data)
+bool Http::Response::parseStatusLine(const char* begin, const char* end)
 {
-    std::istringstream in(data);
-
-    // Extract the HTTP version from the first line
-    std::string version;
-    if (in >> version)
-    {
-        if ((version.size() >= 8) && (version[6] == '.') &&
-            (toLower(version.substr(0, 5)) == "http/")   &&
-             isdigit(version[5]) && isdigit(version[7]))
-        {
-            m_majorVersion = version[5] - '0';
-            m_minorVersion = version[7] - '0';
-        }
-        else
-        {
-            // Invalid HTTP version
-            m_status = InvalidResponse;
-            return;
-        }
-    }
-
-    // Extract the status code from the first line
-    int status;
-    if (in >> status)
+    // Extract the HTTP version
+    const char* version = begin;
+    const char* versionEnd = std::find(begin, end, ' ');
+    if ((versionEnd - version >= 8) && (version[6] == '.') &&
+        (toLower(std::string(version, version + 5)) == "http/") &&
+         isdigit(version[5]) && isdigit(version[7]))
     {
-        m_status = static_cast<Status>(status);
+        m_majorVersion = version[5] - '0';
+        m_minorVersion = version[7] - '0';
     }
     else
     {
-        // Invalid status code
-        m_status = InvalidResponse;
-        return;
+        // Invalid HTTP version
+        return false;
     }
 
-    // Ignore the end of the first line
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-    // Parse the other lines, which contain fields, one by one
-    parseFields(in);
-
-    m_body.clear();
+    // Extract the status code
+    const char* code = skipSpaces(versionEnd, end);
+    int status = 0;
+    const char* codeEnd = code;
+    for (; (codeEnd != end) && isdigit(*codeEnd); ++codeEnd)
+        status = status * 10 + (*codeEnd - '0');
 
-    // Determine whether the transfer is chunked
-    if (toLower(getField("transfer-encoding")) != "chunked")
+    if (codeEnd == code)
     {
-        // Not chunked - just read everything at once
-        std::copy(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>(), std::back_inserter(m_body));
+        // Invalid status code
+        return false;
     }
-    else
-    {
-        // Chunked - have to read chunk by chunk
-        std::size_t length;
-
-        // Read all chunks, identified by a chunk-size not being 0
-        while (in >> std::hex >> length)
-        {
-            // Drop the rest of the line (chunk-extension)
-            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-            // Copy the actual content data
-            std::istreambuf_iterator<char> it(in);
-            for (std::size_t i = 0; i < length; i++)
-                m_body.push_back(*it++);
-        }
-
-        // Drop the rest of the line (chunk-extension)
-        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
-        // Read all trailers (if present)
-        parseFields(in);
-    }
+    m_status = static_cast<Status>(status);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Http::Response::parseFields(std::istream &in)
+void Http::Response::parseField(const char* begin, const char* end)
 {
-    std::string line;
-    while (std::getline(in, line) && (line.size() > 2))
+    const char* colon = std::find(begin, end, ':');
+    if (colon != end)
     {
-        std::string::size_type pos = line.find(": ");
-        if (pos != std::string::npos)
-        {
-            // Extract the field name and its value
-            std::string field = line.substr(0, pos);
-            std::string value = line.substr(pos + 2);
+        // Extract the field name and its value
+        std::string field(begin, colon);
+        std::string value(skipSpaces(colon + 1, end), end);
 
-            // Remove any trailing \r
-            if (!value.empty() && (*value.rbegin() == '\r'))
-                value.erase(value.size() - 1);
-
-            // Add the field
-            m_fields[toLower(field)] = value;
-        }
+        // Add the field
+        m_fields[toLower(field)] = value;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 Http::Http() :
-m_host(),
-m_port(0)
+m_host     (),
+m_port     (0),
+m_keepAlive(false),
+m_connected(false),
+m_bufferPos(0)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Http(const std::string& host, unsigned short port)
+Http::Http(const std::string& host, unsigned short port) :
+m_keepAlive(false),
+m_connected(false),
+m_bufferPos(0)
 {
     setHost(host, port);
 }
@@ -315,6 +279,9 @@ Http::Http(const std::string& host, unsigned short port)
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
 {
+    // The current connection is for the previous host
+    disconnect();
+
     // Check the protocol
     if (toLower(host.substr(0, 7)) == "http://")
     {
@@ -347,68 +314,397 @@ void Http::setHost(const std::string& host, unsigned short port)
 ////////////////////////////////////////////////////////////
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
 {
-    // First make sure that the request is valid -- add missing mandatory fields
-    Request toSend(request);
-    if (!toSend.hasField("From"))
+    std::vector<Request> requests(1, request);
+    std::vector<Response> responses(1);
+    exchange(requests, responses, NULL, timeout);
+
+    return responses[0];
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, BodyHandler& handler, Time timeout)
+{
+    std::vector<Request> requests(1, request);
+    std::vector<Response> responses(1);
+    exchange(requests, responses, &handler, timeout);
+
+    return responses[0];
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Http::Response> Http::sendRequests(const std::vector<Request>& requests, Time timeout)
+{
+    std::vector<Response> responses(requests.size());
+    exchange(requests, responses, NULL, timeout);
+
+    return responses;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setKeepAlive(bool keepAlive)
+{
+    m_keepAlive = keepAlive;
+
+    if (!keepAlive)
+        disconnect();
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::disconnect()
+{
+    if (m_connected)
+    {
+        m_connection.disconnect();
+        m_connected = false;
+    }
+
+    m_buffer.clear();
+    m_bufferPos = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::completeRequest(Request& request) const
+{
+    // Make sure that the request is valid -- add missing mandatory fields
+    if (!request.hasField("From"))
     {
-        toSend.setField("From", "user@sfml-dev.org");
+        request.setField("From", "user@sfml-dev.org");
     }
-    if (!toSend.hasField("User-Agent"))
+    if (!request.hasField("User-Agent"))
     {
-        toSend.setField("User-Agent", "libsfml-network/2.x");
+        request.setField("User-Agent", "libsfml-network/2.x");
     }
-    if (!toSend.hasField("Host"))
+    if (!request.hasField("Host"))
     {
-        toSend.setField("Host", m_hostName);
+        request.setField("Host", m_hostName);
     }
-    if (!toSend.hasField("Content-Length"))
+    if (!request.hasField("Content-Length"))
     {
         std::ostringstream out;
-        out << toSend.m_body.size();
-        toSend.setField("Content-Length", out.str());
+        out << request.m_body.size();
+        request.setField("Content-Length", out.str());
     }
-    if ((toSend.m_method == Request::Post) && !toSend.hasField("Content-Type"))
+    if ((request.m_method == Request::Post) && !request.hasField("Content-Type"))
     {
-        toSend.setField("Content-Type", "application/x-www-form-urlencoded");
+        request.setField("Content-Type", "application/x-www-form-urlencoded");
     }
-    if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
+    if (!request.hasField("Connection"))
     {
-        toSend.setField("Connection", "close");
+        // HTTP 1.0 closes connections by default, HTTP 1.1 keeps them open
+        if (m_keepAlive)
+            request.setField("Connection", "keep-alive");
+        else if (request.m_majorVersion * 10 + request.m_minorVersion >= 11)
+            request.setField("Connection", "close");
     }
+}
+
 
-    // Prepare the response
-    Response received;
+////////////////////////////////////////////////////////////
+void Http::exchange(const std::vector<Request>& requests, std::vector<Response>& responses, BodyHandler* handler, Time timeout)
+{
+    // Convert the requests to strings
+    std::vector<std::string> prepared(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        Request toSend(requests[i]);
+        completeRequest(toSend);
+        prepared[i] = toSend.prepare();
+    }
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host, m_port, timeout) == Socket::Done)
+    std::size_t done = 0;
+    while (done < requests.size())
     {
-        // Convert the request to string and send it through the connected socket
-        std::string requestStr = toSend.prepare();
+        // Connect the socket to the host, unless the previous connection is still open
+        bool reused = m_connected;
+        if (!m_connected)
+        {
+            if (m_connection.connect(m_host, m_port, timeout) != Socket::Done)
+                return;
+
+            m_connected = true;
+        }
+
+        // Send all the remaining requests at once if the connection is persistent,
+        // otherwise it will be closed after the first response anyway
+        std::size_t count = m_keepAlive ? requests.size() - done : 1;
+        std::string data;
+        for (std::size_t i = done; i < done + count; ++i)
+            data += prepared[i];
+
+        if (m_connection.send(data.c_str(), data.size()) != Socket::Done)
+        {
+            disconnect();
+
+            // The server may have closed the connection while it was unused
+            if (reused)
+                continue;
+
+            return;
+        }
 
-        if (!requestStr.empty())
+        // Wait for the server's responses
+        ReceiveResult result = KeepConnection;
+        std::size_t received = 0;
+        while ((received < count) && (result == KeepConnection))
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done)
+            result = receiveResponse(responses[done], requests[done], handler);
+            if (result != NoResponse)
             {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
-                {
-                    receivedStr.append(buffer, buffer + size);
-                }
-
-                // Build the Response object from the received data
-                received.parse(receivedStr);
+                ++received;
+                ++done;
             }
         }
 
-        // Close the connection
-        m_connection.disconnect();
+        if (result != KeepConnection)
+            disconnect();
+
+        // If the server closed the connection before answering, the requests
+        // that were not answered are sent again on a new connection; but if it
+        // didn't answer anything on a new connection, it won't do better next time
+        if ((result == NoResponse) && (received == 0) && !reused)
+        {
+            responses[done].m_status = Response::InvalidResponse;
+            return;
+        }
     }
+}
+
+
+////////////////////////////////////////////////////////////
+Http::ReceiveResult Http::receiveResponse(Response& response, const Request& request, BodyHandler* handler)
+{
+    std::size_t begin, end;
+    for (;;)
+    {
+        // Read the status line
+        if (!receiveLine(begin, end))
+        {
+            if (m_bufferPos == m_buffer.size())
+                return NoResponse;
+
+            response.m_status = Response::InvalidResponse;
+            return CloseConnection;
+        }
+
+        if (!response.parseStatusLine(&m_buffer[0] + begin, &m_buffer[0] + end))
+        {
+            response.m_status = Response::InvalidResponse;
+            return CloseConnection;
+        }
+
+        // Read the header fields, up to the empty line
+        for (;;)
+        {
+            if (!receiveLine(begin, end))
+            {
+                response.m_status = Response::InvalidResponse;
+                return CloseConnection;
+            }
+
+            if (begin == end)
+                break;
+
+            response.parseField(&m_buffer[0] + begin, &m_buffer[0] + end);
+        }
+
+        // Interim responses (100 Continue, 102 Processing, ...) are followed by
+        // the actual answer to the request; 101 Switching Protocols is final,
+        // the connection doesn't talk HTTP anymore after it
+        int interim = response.m_status;
+        if ((interim < 100) || (interim >= 200) || (interim == 101))
+            break;
+
+        response = Response();
+    }
+
+    // Find out whether the server keeps the connection open
+    std::string connection = toLower(response.getField("connection"));
+    bool persistent = (response.m_majorVersion * 10 + response.m_minorVersion >= 11) ? (connection != "close") : (connection == "keep-alive");
+    Request::FieldTable::const_iterator requested = request.m_fields.find("connection");
+    if (!m_keepAlive || ((requested != request.m_fields.end()) && (toLower(requested->second) == "close")))
+        persistent = false;
+
+    // Some responses never have a body
+    int status = response.m_status;
+    if ((request.m_method == Request::Head) || ((status >= 100) && (status < 200)) || (status == Response::NoContent) || (status == Response::NotModified))
+        return persistent ? KeepConnection : CloseConnection;
+
+    if (toLower(response.getField("transfer-encoding")) == "chunked")
+    {
+        // Chunked - have to read chunk by chunk, until one has a size of 0
+        for (;;)
+        {
+            if (!receiveLine(begin, end))
+                return CloseConnection;
+
+            // The chunk size is in hexadecimal, possibly followed by a chunk-extension
+            std::size_t length = 0;
+            const char* digit = &m_buffer[0] + begin;
+            for (; (digit != &m_buffer[0] + end) && isxdigit(*digit); ++digit)
+                length = length * 16 + (isdigit(*digit) ? *digit - '0' : tolower(*digit) - 'a' + 10);
+
+            if (digit == &m_buffer[0] + begin)
+                return CloseConnection;
+
+            if (length == 0)
+                break;
+
+            if (!receiveBody(response, handler, length) || !receiveLine(begin, end))
+                return CloseConnection;
+        }
+
+        // Read all trailers (if present)
+        for (;;)
+        {
+            if (!receiveLine(begin, end))
+                return CloseConnection;
+
+            if (begin == end)
+                break;
+
+            response.parseField(&m_buffer[0] + begin, &m_buffer[0] + end);
+        }
+
+        return persistent ? KeepConnection : CloseConnection;
+    }
+
+    const std::string& contentLength = response.getField("content-length");
+    if (!contentLength.empty())
+    {
+        // Known length - read exactly the body
+        std::size_t length = 0;
+        bool valid = isdigit(contentLength[0]) != 0;
+        for (std::string::const_iterator it = contentLength.begin(); valid && (it != contentLength.end()) && isdigit(*it); ++it)
+        {
+            std::size_t digit = static_cast<std::size_t>(*it - '0');
+            if (length > (static_cast<std::size_t>(-1) - 1 - digit) / 10)
+                valid = false;
+            else
+                length = length * 10 + digit;
+        }
+
+        // A length that can't be parsed can't be trusted either: fall back
+        // to reading the body until the server closes the connection
+        if (valid)
+        {
+            if (!receiveBody(response, handler, length))
+                return CloseConnection;
+
+            return persistent ? KeepConnection : CloseConnection;
+        }
+    }
+
+    // Unknown length - read everything until the server closes the connection
+    receiveBody(response, handler, static_cast<std::size_t>(-1));
+    return CloseConnection;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveBody(Response& response, BodyHandler* handler, std::size_t length)
+{
+    while (length > 0)
+    {
+        // Process the data already received
+        std::size_t available = std::min(length, m_buffer.size() - m_bufferPos);
+        if (available > 0)
+        {
+            const char* data = &m_buffer[0] + m_bufferPos;
+            m_bufferPos += available;
+            length -= available;
+
+            if (handler)
+            {
+                if (!handler->onBodyData(response, data, available))
+                    return false;
+            }
+            else
+            {
+                response.m_body.append(data, available);
+            }
+
+            continue;
+        }
+
+        if (!handler && (length != static_cast<std::size_t>(-1)))
+        {
+            // The size of the body is known: receive it directly into the response,
+            // growing it as data arrives so that a bogus length can't exhaust memory
+            const std::size_t chunkSize = 65536;
+            while (length > 0)
+            {
+                std::size_t start = response.m_body.size();
+                std::size_t size = std::min(length, chunkSize);
+                response.m_body.resize(start + size);
+
+                std::size_t received = 0;
+                Socket::Status status = m_connection.receive(&response.m_body[start], size, received);
+                response.m_body.resize(start + received);
+                if (status != Socket::Done)
+                    return false;
+
+                length -= received;
+            }
+
+            return true;
+        }
+
+        if (!fillBuffer())
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveLine(std::size_t& begin, std::size_t& end)
+{
+    for (;;)
+    {
+        // Look for the end of the line in the data already received
+        std::vector<char>::iterator newLine = std::find(m_buffer.begin() + m_bufferPos, m_buffer.end(), '\n');
+        if (newLine != m_buffer.end())
+        {
+            begin = m_bufferPos;
+            end = newLine - m_buffer.begin();
+            m_bufferPos = end + 1;
+
+            // Remove the trailing \r
+            if ((end > begin) && (m_buffer[end - 1] == '\r'))
+                --end;
+
+            return true;
+        }
+
+        if (!fillBuffer())
+            return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::fillBuffer()
+{
+    // Drop the data already processed
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_bufferPos);
+    m_bufferPos = 0;
+
+    // Receive directly at the end of the buffer
+    const std::size_t chunkSize = 16384;
+    std::size_t size = m_buffer.size();
+    m_buffer.resize(size + chunkSize);
+
+    std::size_t received = 0;
+    Socket::Status status = m_connection.receive(&m_buffer[size], chunkSize, received);
+    m_buffer.resize(size + received);
 
-    return received;
+    return status == Socket::Done;
 }
 
 } // namespace sf
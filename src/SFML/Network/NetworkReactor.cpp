@@ -0,0 +1,854 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkReactor.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Maximum number of events processed for a single socket before
+    // the other sockets get their turn
+    const int maxEventsPerSocket = 64;
+
+    // Longest wait of a thread which couldn't create its wake up socket
+    const sf::Time pollInterval = sf::milliseconds(10);
+
+    // Remove all the occurrences of a value from a vector
+    template <typename T>
+    void eraseValue(std::vector<T>& vector, const T& value)
+    {
+        vector.erase(std::remove(vector.begin(), vector.end(), value), vector.end());
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct NetworkReactor::Entry
+{
+    Entry(Socket& socket) :
+    socket      (&socket),
+    tcp         (NULL),
+    listener    (NULL),
+    udp         (NULL),
+    owned       (false),
+    shard       (NULL),
+    pending     (false),
+    removed     (false),
+    sendingHead (0),
+    inserted    (false),
+    watchingSend(false)
+    {
+    }
+
+    Socket*             socket;       ///< The socket
+    TcpSocket*          tcp;          ///< The socket, if it is a TCP socket
+    TcpListener*        listener;     ///< The socket, if it is a listener
+    UdpSocket*          udp;          ///< The socket, if it is a UDP socket
+    bool                owned;        ///< Was the socket created by the reactor?
+    Shard*              shard;        ///< Thread which serves the socket
+    std::vector<Packet> queue;        ///< Packets queued by send (protected by the shard mutex)
+    bool                pending;      ///< Is the thread in charge of sending queued packets? (protected by the shard mutex)
+    bool                removed;      ///< Was the socket removed? (protected by the shard mutex)
+    std::vector<Packet> sending;      ///< Packets being sent (used only by the thread)
+    std::size_t         sendingHead;  ///< Index of the first packet of sending not sent yet (used only by the thread)
+    bool                inserted;     ///< Is the socket watched by its thread? (used only by the thread)
+    bool                watchingSend; ///< Does the selector wait until the socket can send? (used only by the thread)
+};
+
+
+////////////////////////////////////////////////////////////
+struct NetworkReactor::Shard
+{
+    ////////////////////////////////////////////////////////////
+    Shard(NetworkReactor& owner, bool runsTimers) :
+    reactor   (owner),
+    timers    (runsTimers),
+    woken     (false),
+    wakePort  (0),
+    thread    (NULL)
+    {
+        // The other threads wake this one up by sending it a datagram,
+        // this way the selector returns immediately; the socket is bound
+        // to the loopback interface so that other hosts can't reach it
+        if (wakeReceiver.bind(Socket::AnyPort, IpAddress::LocalHost) == Socket::Done)
+        {
+            wakeReceiver.setBlocking(false);
+            wakePort = wakeReceiver.getLocalPort();
+            selector.add(wakeReceiver);
+        }
+        else
+        {
+            err() << "Failed to create the wake up socket of a network reactor thread, "
+                  << "it will poll for commands instead" << std::endl;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wake()
+    {
+        Lock lock(mutex);
+
+        if (!woken && wakePort)
+        {
+            woken = true;
+            char signal = 0;
+            wakeSender.send(&signal, sizeof(signal), IpAddress::LocalHost, wakePort);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        while (!reactor.isStopping())
+        {
+            processCommands();
+
+            // Compute how long we can wait for events
+            Time timeout = Time::Zero;
+            if (timers)
+                timeout = reactor.runTimers();
+
+            // Without wake up signals, the commands can only be noticed by polling
+            if (!wakePort && ((timeout == Time::Zero) || (timeout > pollInterval)))
+                timeout = pollInterval;
+
+            sendPending();
+
+            if (selector.wait(timeout))
+                dispatch();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void watch(Entry* entry)
+    {
+        {
+            Lock reactorLock(reactor.m_mutex);
+
+            // Nobody else uses the thread: insert the socket immediately
+            if (!reactor.m_running)
+            {
+                insert(entry);
+                return;
+            }
+
+            Lock lock(mutex);
+            added.push_back(entry);
+        }
+
+        wake();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void processCommands()
+    {
+        std::vector<Entry*> toAdd;
+        std::vector<Entry*> toRemove;
+        {
+            Lock lock(mutex);
+            toAdd.swap(added);
+            toRemove.swap(removed);
+        }
+
+        for (std::vector<Entry*>::iterator it = toAdd.begin(); it != toAdd.end(); ++it)
+            insert(*it);
+
+        // A socket may be removed before its thread got it (this happens
+        // when an accepted connection is refused directly in onAccept):
+        // in this case its removal has to wait until it is added
+        std::vector<Entry*> postponed;
+        for (std::vector<Entry*>::iterator it = toRemove.begin(); it != toRemove.end(); ++it)
+        {
+            if ((*it)->inserted)
+                close(*it);
+            else
+                postponed.push_back(*it);
+        }
+
+        if (!postponed.empty())
+        {
+            Lock lock(mutex);
+            removed.insert(removed.end(), postponed.begin(), postponed.end());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void insert(Entry* entry)
+    {
+        entry->inserted = true;
+        entries[entry->socket] = entry;
+
+        if (entry->listener)
+            selector.add(*entry->listener);
+        else if (entry->tcp)
+            selector.add(*entry->tcp);
+        else
+            selector.add(*entry->udp);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close(Entry* entry)
+    {
+        // Forget the socket everywhere; send never uses an entry which is
+        // not in the table of its thread, so it is safe to destroy it afterwards
+        {
+            Lock lock(mutex);
+            registered.erase(entry->socket);
+            entry->removed = true;
+            if (entry->pending)
+                eraseValue(pending, entry);
+            eraseValue(removed, entry);
+        }
+
+        if (entry->listener)
+            selector.remove(*entry->listener);
+        else if (entry->tcp)
+            selector.remove(*entry->tcp);
+        else
+            selector.remove(*entry->udp);
+        entries.erase(entry->socket);
+
+        reactor.m_handler.onRemove(reactor, *entry->socket);
+
+        if (entry->owned)
+            delete entry->socket;
+        delete entry;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void sendPending()
+    {
+        std::vector<Entry*> toSend;
+        {
+            Lock lock(mutex);
+            toSend.swap(pending);
+        }
+
+        // The packets queued since the previous iteration are sent right away,
+        // the sockets which can't send everything wait until they are writable
+        for (std::vector<Entry*>::iterator it = toSend.begin(); it != toSend.end(); ++it)
+        {
+            // An accepted socket may get packets before its thread watches it
+            if (!(*it)->inserted)
+            {
+                Lock lock(mutex);
+                pending.push_back(*it);
+                continue;
+            }
+
+            flush(*it);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool flush(Entry* entry)
+    {
+        // The packets are sent without holding the mutex, send can
+        // queue more of them meanwhile: we take them until there's none
+        Socket::Status status = Socket::Done;
+        bool sentAll = false;
+        while (status == Socket::Done)
+        {
+            {
+                Lock lock(mutex);
+
+                if (entry->queue.empty() && (entry->sendingHead == entry->sending.size()))
+                {
+                    entry->pending = false;
+                    sentAll = true;
+                    break;
+                }
+
+                if (entry->sending.empty())
+                    entry->sending.swap(entry->queue);
+                else
+                    entry->sending.insert(entry->sending.end(), entry->queue.begin(), entry->queue.end());
+                entry->queue.clear();
+            }
+
+            std::size_t sent = 0;
+            std::size_t count = entry->sending.size() - entry->sendingHead;
+            status = entry->tcp->sendBatch(&entry->sending[entry->sendingHead], count, sent);
+            entry->sendingHead += sent;
+
+            if (status == Socket::Done)
+            {
+                entry->sending.clear();
+                entry->sendingHead = 0;
+            }
+        }
+
+        if (sentAll)
+        {
+            if (entry->watchingSend)
+            {
+                selector.setSendMonitoring(*entry->tcp, false);
+                entry->watchingSend = false;
+            }
+
+            reactor.m_handler.onWritable(reactor, *entry->tcp);
+            return true;
+        }
+        else if ((status == Socket::NotReady) || (status == Socket::Partial))
+        {
+            // Don't let the sent packets accumulate at the front of the queue
+            if (entry->sendingHead * 2 >= entry->sending.size())
+            {
+                entry->sending.erase(entry->sending.begin(), entry->sending.begin() + entry->sendingHead);
+                entry->sendingHead = 0;
+            }
+
+            // Try again when the socket can accept more data
+            if (!entry->watchingSend)
+            {
+                selector.setSendMonitoring(*entry->tcp, true);
+                entry->watchingSend = true;
+            }
+
+            return true;
+        }
+        else
+        {
+            reactor.m_handler.onDisconnect(reactor, *entry->tcp);
+            close(entry);
+            return false;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void dispatch()
+    {
+        // Sockets may be removed while we process the events, so we can't
+        // iterate directly on the selector's list
+        std::vector<Socket*> ready(selector.beginReady(), selector.endReady());
+
+        for (std::vector<Socket*>::iterator it = ready.begin(); it != ready.end(); ++it)
+        {
+            if (*it == &wakeReceiver)
+            {
+                drainWakeSignals();
+                continue;
+            }
+
+            std::map<Socket*, Entry*>::iterator found = entries.find(*it);
+            if (found == entries.end())
+                continue;
+
+            Entry* entry = found->second;
+            if (entry->listener)
+            {
+                acceptConnections(entry);
+            }
+            else if (entry->tcp)
+            {
+                // Sending may fail and remove the socket
+                if (selector.isReadyToSend(*entry->tcp) && !flush(entry))
+                    continue;
+
+                if (selector.isReady(*entry->tcp))
+                    receivePackets(entry);
+            }
+            else
+            {
+                receiveDatagrams(entry);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void drainWakeSignals()
+    {
+        char buffer[64];
+        std::size_t received = 0;
+        IpAddress address;
+        unsigned short port = 0;
+        while (wakeReceiver.receive(buffer, sizeof(buffer), received, address, port) == Socket::Done)
+        {
+        }
+
+        // The commands pushed from now on need a new signal; the ones
+        // pushed before are processed at the end of this iteration
+        Lock lock(mutex);
+        woken = false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void acceptConnections(Entry* entry)
+    {
+        for (int i = 0; i < maxEventsPerSocket; ++i)
+        {
+            TcpSocket* socket = new TcpSocket;
+            if (entry->listener->accept(*socket) != Socket::Done)
+            {
+                delete socket;
+                break;
+            }
+
+            socket->setBlocking(false);
+
+            // The new socket is registered before the handler knows it, so
+            // that it can send to it or remove it right away; but its thread
+            // only watches it once onAccept has returned, so that no other
+            // callback of the socket can run before or during onAccept
+            Entry* accepted = new Entry(*socket);
+            accepted->tcp = socket;
+            accepted->owned = true;
+            Shard* shard = reactor.registerEntry(accepted);
+
+            reactor.m_handler.onAccept(reactor, *entry->listener, *socket);
+
+            shard->watch(accepted);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void receivePackets(Entry* entry)
+    {
+        for (int i = 0; i < maxEventsPerSocket; ++i)
+        {
+            Socket::Status status = entry->tcp->receive(packet);
+            if (status == Socket::Done)
+            {
+                reactor.m_handler.onPacket(reactor, *entry->tcp, packet);
+            }
+            else
+            {
+                if ((status == Socket::Disconnected) || (status == Socket::Error))
+                {
+                    reactor.m_handler.onDisconnect(reactor, *entry->tcp);
+                    close(entry);
+                }
+                break;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void receiveDatagrams(Entry* entry)
+    {
+        IpAddress address;
+        unsigned short port = 0;
+        for (int i = 0; i < maxEventsPerSocket; ++i)
+        {
+            if (entry->udp->receive(packet, address, port) != Socket::Done)
+                break;
+
+            reactor.m_handler.onDatagram(reactor, *entry->udp, packet, address, port);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    NetworkReactor&           reactor;      ///< Owner of the thread
+    bool                      timers;       ///< Does this thread run the timers?
+    SocketSelector            selector;     ///< Selector watching the sockets of the thread
+    std::map<Socket*, Entry*> entries;      ///< Sockets watched by the selector
+    Packet                    packet;       ///< Packet receiving the incoming data
+    UdpSocket                 wakeReceiver; ///< Socket receiving the wake up signals
+    UdpSocket                 wakeSender;   ///< Socket sending the wake up signals
+    Mutex                     mutex;        ///< Mutex protecting the members below
+    std::map<Socket*, Entry*> registered;   ///< Sockets served by the thread, watched or not yet
+    std::vector<Entry*>       added;        ///< Sockets to add to the selector
+    std::vector<Entry*>       removed;      ///< Sockets to remove from the selector
+    std::vector<Entry*>       pending;      ///< Sockets which have new packets to send
+    bool                      woken;        ///< Was a wake up signal sent and not received yet?
+    unsigned short            wakePort;     ///< Port of the socket receiving the wake up signals
+    Thread*                   thread;       ///< Thread running the loop (NULL for the main one)
+};
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onAccept(NetworkReactor&, TcpListener&, TcpSocket&)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onPacket(NetworkReactor&, TcpSocket&, Packet&)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onDatagram(NetworkReactor&, UdpSocket&, Packet&, const IpAddress&, unsigned short)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onWritable(NetworkReactor&, TcpSocket&)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onDisconnect(NetworkReactor&, TcpSocket&)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onRemove(NetworkReactor&, Socket&)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::Handler::onTimer(NetworkReactor&, TimerId)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::NetworkReactor(Handler& handler, unsigned int threadCount) :
+m_handler  (handler),
+m_running  (false),
+m_stopping (false),
+m_nextTimer(1)
+{
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_shards.push_back(new Shard(*this, i == 0));
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::~NetworkReactor()
+{
+    for (std::vector<Shard*>::iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+    {
+        std::map<Socket*, Entry*>& registered = (*it)->registered;
+        for (std::map<Socket*, Entry*>::iterator entry = registered.begin(); entry != registered.end(); ++entry)
+        {
+            if (entry->second->owned)
+                delete entry->second->socket;
+            delete entry->second;
+        }
+
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::add(TcpListener& listener)
+{
+    listener.setBlocking(false);
+
+    Entry* entry = new Entry(listener);
+    entry->listener = &listener;
+    addEntry(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::add(TcpSocket& socket)
+{
+    socket.setBlocking(false);
+
+    Entry* entry = new Entry(socket);
+    entry->tcp = &socket;
+    addEntry(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::add(UdpSocket& socket)
+{
+    socket.setBlocking(false);
+
+    Entry* entry = new Entry(socket);
+    entry->udp = &socket;
+    addEntry(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::remove(Socket& socket)
+{
+    Shard* shard = getShard(socket);
+    Entry* entry = NULL;
+    bool running = false;
+    {
+        Lock lock(m_mutex);
+        Lock shardLock(shard->mutex);
+
+        std::map<Socket*, Entry*>::iterator it = shard->registered.find(&socket);
+        if (it == shard->registered.end())
+            return;
+
+        entry = it->second;
+        running = m_running;
+
+        if (running)
+        {
+            // Let the thread which serves the socket remove it
+            if (entry->removed)
+                return;
+
+            entry->removed = true;
+            shard->removed.push_back(entry);
+        }
+    }
+
+    if (running)
+        shard->wake();
+    else
+        shard->close(entry); // Nobody else uses the socket: remove it immediately
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::send(TcpSocket& socket, const Packet& packet)
+{
+    // Only the thread which serves the socket is involved, so that
+    // sending to sockets of different threads doesn't serialize them
+    Shard* shard = getShard(socket);
+    {
+        Lock lock(shard->mutex);
+
+        std::map<Socket*, Entry*>::iterator it = shard->registered.find(&socket);
+        if (it == shard->registered.end())
+            return;
+
+        Entry* entry = it->second;
+        if (entry->removed)
+            return;
+
+        entry->queue.push_back(packet);
+        if (!entry->pending)
+        {
+            entry->pending = true;
+            shard->pending.push_back(entry);
+        }
+    }
+
+    shard->wake();
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::TimerId NetworkReactor::startTimer(Time delay, Time interval)
+{
+    TimerId timer;
+    {
+        Lock lock(m_mutex);
+
+        timer = m_nextTimer++;
+        m_timers[timer] = interval.asMicroseconds();
+        m_timerQueue.insert(std::make_pair(m_clock.getElapsedTime().asMicroseconds() + delay.asMicroseconds(), timer));
+    }
+
+    // The new timer may expire before the ones the main thread is waiting for
+    m_shards[0]->wake();
+
+    return timer;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::stopTimer(TimerId timer)
+{
+    // The expirations of the timer are discarded when they come up
+    Lock lock(m_mutex);
+    m_timers.erase(timer);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::run()
+{
+    {
+        Lock lock(m_mutex);
+        m_running = true;
+    }
+
+    // Launch the additional threads, the calling thread is the main one
+    for (std::size_t i = 1; i < m_shards.size(); ++i)
+    {
+        m_shards[i]->thread = new Thread(&Shard::run, m_shards[i]);
+        m_shards[i]->thread->launch();
+    }
+
+    m_shards[0]->run();
+
+    for (std::size_t i = 1; i < m_shards.size(); ++i)
+    {
+        m_shards[i]->thread->wait();
+        delete m_shards[i]->thread;
+        m_shards[i]->thread = NULL;
+    }
+
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+        m_stopping = false;
+    }
+
+    // Apply the commands that the threads didn't process before stopping
+    for (std::vector<Shard*>::iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+        (*it)->processCommands();
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::stop()
+{
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+    }
+
+    for (std::vector<Shard*>::iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+        (*it)->wake();
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::addEntry(Entry* entry)
+{
+    Shard* shard = registerEntry(entry);
+    if (shard)
+        shard->watch(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::Shard* NetworkReactor::registerEntry(Entry* entry)
+{
+    Shard* shard = getShard(*entry->socket);
+
+    Lock lock(shard->mutex);
+
+    // Adding a socket twice has no effect
+    if (shard->registered.find(entry->socket) != shard->registered.end())
+    {
+        delete entry;
+        return NULL;
+    }
+
+    entry->shard = shard;
+    shard->registered[entry->socket] = entry;
+
+    return shard;
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::Shard* NetworkReactor::getShard(const Socket& socket) const
+{
+    // The thread is derived from the address of the socket, so that finding
+    // it doesn't need any shared table; the lowest bits are dropped since
+    // they only reflect the alignment of the allocations
+    std::size_t address = reinterpret_cast<std::size_t>(&socket);
+    std::size_t hash = (address >> 4) ^ (address >> 12) ^ (address >> 20);
+
+    return m_shards[hash % m_shards.size()];
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::isStopping() const
+{
+    Lock lock(m_mutex);
+    return m_stopping;
+}
+
+
+////////////////////////////////////////////////////////////
+Time NetworkReactor::runTimers()
+{
+    std::vector<TimerId> expired;
+    {
+        Lock lock(m_mutex);
+
+        Int64 now = m_clock.getElapsedTime().asMicroseconds();
+        while (!m_timerQueue.empty() && (m_timerQueue.begin()->first <= now))
+        {
+            Int64 deadline = m_timerQueue.begin()->first;
+            TimerId timer = m_timerQueue.begin()->second;
+            m_timerQueue.erase(m_timerQueue.begin());
+
+            // Skip the timers that were stopped
+            TimerTable::iterator it = m_timers.find(timer);
+            if (it == m_timers.end())
+                continue;
+
+            if (it->second > 0)
+            {
+                // Keep the period stable, unless we're late by more than one period
+                deadline += it->second;
+                if (deadline <= now)
+                    deadline = now + it->second;
+                m_timerQueue.insert(std::make_pair(deadline, timer));
+            }
+            else
+            {
+                m_timers.erase(it);
+            }
+
+            expired.push_back(timer);
+        }
+    }
+
+    for (std::vector<TimerId>::iterator it = expired.begin(); it != expired.end(); ++it)
+        m_handler.onTimer(*this, *it);
+
+    Lock lock(m_mutex);
+
+    if (m_timerQueue.empty())
+        return Time::Zero;
+
+    // Time::Zero means "no timer", so never return it for an expired timer
+    Int64 remaining = m_timerQueue.begin()->first - m_clock.getElapsedTime().asMicroseconds();
+    return microseconds(std::max(remaining, static_cast<Int64>(1)));
+}
+
+} // namespace sf
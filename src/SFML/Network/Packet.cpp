@@ -32,13 +32,91 @@
 #include <cwchar>
 
 
+namespace
+{
+    // Reverse the bytes of integers
+    sf::Uint16 swap(sf::Uint16 value)
+    {
+        return static_cast<sf::Uint16>((value << 8) | (value >> 8));
+    }
+
+    sf::Uint32 swap(sf::Uint32 value)
+    {
+        return ((value & 0x000000FF) << 24) | ((value & 0x0000FF00) <<  8) |
+               ((value & 0x00FF0000) >>  8) | ((value & 0xFF000000) >> 24);
+    }
+
+    sf::Uint64 swap(sf::Uint64 value)
+    {
+        return (static_cast<sf::Uint64>(swap(static_cast<sf::Uint32>(value))) << 32) | swap(static_cast<sf::Uint32>(value >> 32));
+    }
+
+    // Copy an array of integers, reversing the bytes of each element
+    template <typename T>
+    void copySwapped(char* destination, const char* source, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T value;
+            std::memcpy(&value, source + i * sizeof(T), sizeof(T));
+            value = swap(value);
+            std::memcpy(destination + i * sizeof(T), &value, sizeof(T));
+        }
+    }
+
+    // Copy an array of elements, converting them between the host and network byte orders
+    void copyToNetworkOrder(char* destination, const char* source, std::size_t count, std::size_t elementSize)
+    {
+        // Network byte order is big endian, nothing to do on big endian hosts
+        if (htonl(1) == 1)
+        {
+            std::memcpy(destination, source, count * elementSize);
+            return;
+        }
+
+        switch (elementSize)
+        {
+            case 2:  copySwapped<sf::Uint16>(destination, source, count); break;
+            case 4:  copySwapped<sf::Uint32>(destination, source, count); break;
+            case 8:  copySwapped<sf::Uint64>(destination, source, count); break;
+            default: std::memcpy(destination, source, count * elementSize); break;
+        }
+    }
+
+    // Write wide characters as 32-bit integers in network byte order
+    void copyWideCharacters(char* destination, const wchar_t* source, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Uint32 character = htonl(static_cast<sf::Uint32>(source[i]));
+            std::memcpy(destination + i * sizeof(sf::Uint32), &character, sizeof(sf::Uint32));
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_sendPos(0),
-m_isValid(true)
+m_view    (NULL),
+m_viewSize(0),
+m_readPos (0),
+m_sendPos (0),
+m_isValid (true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Packet::Packet(const Packet& copy) :
+m_data    (static_cast<const char*>(copy.getData()), static_cast<const char*>(copy.getData()) + copy.getDataSize()),
+m_view    (NULL),
+m_viewSize(0),
+m_readPos (copy.m_readPos),
+m_sendPos (copy.m_sendPos),
+m_isValid (copy.m_isValid)
 {
 
 }
@@ -51,22 +129,53 @@ Packet::~Packet()
 }
 
 
+////////////////////////////////////////////////////////////
+Packet& Packet::operator =(const Packet& right)
+{
+    if (this != &right)
+    {
+        // Copy the viewed data as well, the view of the source may not outlive this packet
+        const char* data = static_cast<const char*>(right.getData());
+        m_data.assign(data, data + right.getDataSize());
+        m_view     = NULL;
+        m_viewSize = 0;
+        m_readPos  = right.m_readPos;
+        m_sendPos  = right.m_sendPos;
+        m_isValid  = right.m_isValid;
+    }
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Packet::append(const void* data, std::size_t sizeInBytes)
 {
     if (data && (sizeInBytes > 0))
     {
-        std::size_t start = m_data.size();
-        m_data.resize(start + sizeInBytes);
-        std::memcpy(&m_data[start], data, sizeInBytes);
+        detachView();
+
+        // Inserting copies the bytes directly, unlike resize + memcpy
+        const char* bytes = static_cast<const char*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + sizeInBytes);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t sizeInBytes)
+{
+    detachView();
+    m_data.reserve(sizeInBytes);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Packet::clear()
 {
     m_data.clear();
+    m_view = NULL;
+    m_viewSize = 0;
     m_readPos = 0;
     m_isValid = true;
 }
@@ -75,6 +184,9 @@ void Packet::clear()
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
+    if (m_view)
+        return m_view;
+
     return !m_data.empty() ? &m_data[0] : NULL;
 }
 
@@ -82,14 +194,14 @@ const void* Packet::getData() const
 ////////////////////////////////////////////////////////////
 std::size_t Packet::getDataSize() const
 {
-    return m_data.size();
+    return m_view ? m_viewSize : m_data.size();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Packet::endOfPacket() const
 {
-    return m_readPos >= m_data.size();
+    return m_readPos >= getDataSize();
 }
 
 
@@ -116,7 +228,7 @@ Packet& Packet::operator >>(Int8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const Int8*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const Int8*>(getReadPointer());
         m_readPos += sizeof(data);
     }
 
@@ -129,7 +241,7 @@ Packet& Packet::operator >>(Uint8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const Uint8*>(getReadPointer());
         m_readPos += sizeof(data);
     }
 
@@ -142,7 +254,9 @@ Packet& Packet::operator >>(Int16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohs(*reinterpret_cast<const Int16*>(&m_data[m_readPos]));
+        Int16 value;
+        std::memcpy(&value, getReadPointer(), sizeof(value));
+        data = ntohs(value);
         m_readPos += sizeof(data);
     }
 
@@ -155,7 +269,9 @@ Packet& Packet::operator >>(Uint16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohs(*reinterpret_cast<const Uint16*>(&m_data[m_readPos]));
+        Uint16 value;
+        std::memcpy(&value, getReadPointer(), sizeof(value));
+        data = ntohs(value);
         m_readPos += sizeof(data);
     }
 
@@ -168,7 +284,9 @@ Packet& Packet::operator >>(Int32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohl(*reinterpret_cast<const Int32*>(&m_data[m_readPos]));
+        Int32 value;
+        std::memcpy(&value, getReadPointer(), sizeof(value));
+        data = ntohl(value);
         m_readPos += sizeof(data);
     }
 
@@ -181,7 +299,9 @@ Packet& Packet::operator >>(Uint32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohl(*reinterpret_cast<const Uint32*>(&m_data[m_readPos]));
+        Uint32 value;
+        std::memcpy(&value, getReadPointer(), sizeof(value));
+        data = ntohl(value);
         m_readPos += sizeof(data);
     }
 
@@ -196,7 +316,7 @@ Packet& Packet::operator >>(Int64& data)
     {
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
-        const Uint8* bytes = reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(getReadPointer());
         data = (static_cast<Int64>(bytes[0]) << 56) |
                (static_cast<Int64>(bytes[1]) << 48) |
                (static_cast<Int64>(bytes[2]) << 40) |
@@ -219,7 +339,7 @@ Packet& Packet::operator >>(Uint64& data)
     {
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
-        const Uint8* bytes = reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(getReadPointer());
         data = (static_cast<Uint64>(bytes[0]) << 56) |
                (static_cast<Uint64>(bytes[1]) << 48) |
                (static_cast<Uint64>(bytes[2]) << 40) |
@@ -240,7 +360,7 @@ Packet& Packet::operator >>(float& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const float*>(&m_data[m_readPos]);
+        std::memcpy(&data, getReadPointer(), sizeof(data));
         m_readPos += sizeof(data);
     }
 
@@ -253,7 +373,7 @@ Packet& Packet::operator >>(double& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const double*>(&m_data[m_readPos]);
+        std::memcpy(&data, getReadPointer(), sizeof(data));
         m_readPos += sizeof(data);
     }
 
@@ -271,7 +391,7 @@ Packet& Packet::operator >>(char* data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        std::memcpy(data, &m_data[m_readPos], length);
+        std::memcpy(data, getReadPointer(), length);
         data[length] = '\0';
 
         // Update reading position
@@ -293,7 +413,7 @@ Packet& Packet::operator >>(std::string& data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        data.assign(&m_data[m_readPos], length);
+        data.assign(getReadPointer(), length);
 
         // Update reading position
         m_readPos += length;
@@ -313,13 +433,17 @@ Packet& Packet::operator >>(wchar_t* data)
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
         // Then extract characters
+        const char* characters = getReadPointer();
         for (Uint32 i = 0; i < length; ++i)
         {
-            Uint32 character = 0;
-            *this >> character;
-            data[i] = static_cast<wchar_t>(character);
+            Uint32 character;
+            std::memcpy(&character, characters + i * sizeof(Uint32), sizeof(Uint32));
+            data[i] = static_cast<wchar_t>(ntohl(character));
         }
         data[length] = L'\0';
+
+        // Update reading position
+        m_readPos += length * sizeof(Uint32);
     }
 
     return *this;
@@ -337,12 +461,17 @@ Packet& Packet::operator >>(std::wstring& data)
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
         // Then extract characters
+        data.resize(length);
+        const char* characters = getReadPointer();
         for (Uint32 i = 0; i < length; ++i)
         {
-            Uint32 character = 0;
-            *this >> character;
-            data += static_cast<wchar_t>(character);
+            Uint32 character;
+            std::memcpy(&character, characters + i * sizeof(Uint32), sizeof(Uint32));
+            data[i] = static_cast<wchar_t>(ntohl(character));
         }
+
+        // Update reading position
+        m_readPos += length * sizeof(Uint32);
     }
 
     return *this;
@@ -360,12 +489,9 @@ Packet& Packet::operator >>(String& data)
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
         // Then extract characters
-        for (Uint32 i = 0; i < length; ++i)
-        {
-            Uint32 character = 0;
-            *this >> character;
-            data += character;
-        }
+        std::basic_string<Uint32> characters(length, 0);
+        readArray(&characters[0], length);
+        data = characters;
     }
 
     return *this;
@@ -527,8 +653,13 @@ Packet& Packet::operator <<(const wchar_t* data)
     *this << length;
 
     // Then insert characters
-    for (const wchar_t* c = data; *c != L'\0'; ++c)
-        *this << static_cast<Uint32>(*c);
+    if (length > 0)
+    {
+        detachView();
+        std::size_t start = m_data.size();
+        m_data.resize(start + length * sizeof(Uint32));
+        copyWideCharacters(&m_data[start], data, length);
+    }
 
     return *this;
 }
@@ -544,8 +675,10 @@ Packet& Packet::operator <<(const std::wstring& data)
     // Then insert characters
     if (length > 0)
     {
-        for (std::wstring::const_iterator c = data.begin(); c != data.end(); ++c)
-            *this << static_cast<Uint32>(*c);
+        detachView();
+        std::size_t start = m_data.size();
+        m_data.resize(start + length * sizeof(Uint32));
+        copyWideCharacters(&m_data[start], data.data(), length);
     }
 
     return *this;
@@ -561,10 +694,97 @@ Packet& Packet::operator <<(const String& data)
 
     // Then insert characters
     if (length > 0)
+        writeArray(data.getData(), length);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Int32 data)
+{
+    // Zigzag encoding: 0, -1, 1, -2, 2... become 0, 1, 2, 3, 4...
+    Uint32 encoded = (static_cast<Uint32>(data) << 1) ^ (data < 0 ? 0xFFFFFFFF : 0);
+    return writeVarint(encoded);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Uint32 data)
+{
+    return writeVarint(static_cast<Uint64>(data));
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Int64 data)
+{
+    // Zigzag encoding: 0, -1, 1, -2, 2... become 0, 1, 2, 3, 4...
+    Uint64 encoded = (static_cast<Uint64>(data) << 1) ^ (data < 0 ? ~static_cast<Uint64>(0) : 0);
+    return writeVarint(encoded);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Uint64 data)
+{
+    // Write 7 bits per byte, the high bit tells whether more bytes follow
+    Uint8 bytes[10];
+    std::size_t count = 0;
+    do
     {
-        for (String::ConstIterator c = data.begin(); c != data.end(); ++c)
-            *this << *c;
+        bytes[count] = static_cast<Uint8>(data & 0x7F);
+        data >>= 7;
+        if (data > 0)
+            bytes[count] |= 0x80;
+        ++count;
     }
+    while (data > 0);
+
+    append(bytes, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Int32& data)
+{
+    Uint32 encoded = static_cast<Uint32>(extractVarint(32));
+    if (m_isValid)
+        data = static_cast<Int32>((encoded >> 1) ^ (0 - (encoded & 1)));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Uint32& data)
+{
+    Uint32 value = static_cast<Uint32>(extractVarint(32));
+    if (m_isValid)
+        data = value;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Int64& data)
+{
+    Uint64 encoded = extractVarint(64);
+    if (m_isValid)
+        data = static_cast<Int64>((encoded >> 1) ^ (0 - (encoded & 1)));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Uint64& data)
+{
+    Uint64 value = extractVarint(64);
+    if (m_isValid)
+        data = value;
 
     return *this;
 }
@@ -573,12 +793,109 @@ Packet& Packet::operator <<(const String& data)
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
-    m_isValid = m_isValid && (m_readPos + size <= m_data.size());
+    m_isValid = m_isValid && (m_readPos + size <= getDataSize());
 
     return m_isValid;
 }
 
 
+////////////////////////////////////////////////////////////
+const char* Packet::getReadPointer() const
+{
+    return static_cast<const char*>(getData()) + m_readPos;
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::setView(const void* data, std::size_t size)
+{
+    clear();
+
+    if (data && (size > 0))
+    {
+        m_view = static_cast<const char*>(data);
+        m_viewSize = size;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::detachView()
+{
+    if (m_view)
+    {
+        m_data.assign(m_view, m_view + m_viewSize);
+        m_view = NULL;
+        m_viewSize = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::appendArray(const void* data, std::size_t count, std::size_t elementSize, bool swapBytes)
+{
+    std::size_t size = count * elementSize;
+    if (!data || (size == 0))
+        return;
+
+    if (!swapBytes)
+    {
+        append(data, size);
+        return;
+    }
+
+    detachView();
+    std::size_t start = m_data.size();
+    m_data.resize(start + size);
+    copyToNetworkOrder(&m_data[start], static_cast<const char*>(data), count, elementSize);
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::extractArray(void* data, std::size_t count, std::size_t elementSize, bool swapBytes)
+{
+    std::size_t size = count * elementSize;
+    if ((size == 0) || !checkSize(size))
+        return;
+
+    // Converting from network byte order is the same operation as converting to it
+    if (swapBytes)
+        copyToNetworkOrder(static_cast<char*>(data), getReadPointer(), count, elementSize);
+    else
+        std::memcpy(data, getReadPointer(), size);
+
+    m_readPos += size;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Packet::extractVarint(unsigned int maxBits)
+{
+    Uint64 value = 0;
+    for (unsigned int shift = 0; shift < maxBits; shift += 7)
+    {
+        if (!checkSize(1))
+            return 0;
+
+        Uint8 byte = static_cast<Uint8>(*getReadPointer());
+        ++m_readPos;
+
+        // Reject the bits which don't fit in the requested type
+        Uint64 bits = static_cast<Uint64>(byte & 0x7F) << shift;
+        if ((bits >> shift) != static_cast<Uint64>(byte & 0x7F) || ((maxBits < 64) && (bits >> maxBits)))
+            break;
+
+        value |= bits;
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    // Too many bytes: the data is corrupted
+    m_isValid = false;
+    return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
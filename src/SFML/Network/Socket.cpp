@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/Network/SocketSelector.hpp>
 #include <SFML/System/Err.hpp>
 
 
@@ -45,6 +46,10 @@ m_isBlocking(true)
 ////////////////////////////////////////////////////////////
 Socket::~Socket()
 {
+    // Make sure that no selector keeps a reference to the socket
+    while (!m_selectors.empty())
+        m_selectors.back()->remove(*this);
+
     // Close the socket before it gets destructed
     close();
 }
@@ -75,6 +80,21 @@ SocketHandle Socket::getHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Socket::hasBufferedData() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::onDataBuffered()
+{
+    for (std::vector<SocketSelector*>::iterator it = m_selectors.begin(); it != m_selectors.end(); ++it)
+        (*it)->addBufferedSocket(*this);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Socket::create()
 {
@@ -29,31 +29,203 @@
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <algorithm>
+#include <map>
+#include <set>
 #include <utility>
+#include <vector>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #define SFML_SOCKETSELECTOR_EPOLL
+    #include <sys/epoll.h>
+#endif
+
+#if !defined(SFML_SYSTEM_WINDOWS)
+    #include <poll.h>
+    #include <errno.h>
+#endif
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
 #endif
 
 
+namespace
+{
+    // Flags telling what a socket is ready for
+    const sf::Uint8 readyToReceive = 1;
+    const sf::Uint8 readyToSend    = 2;
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set allSockets;   ///< Set containing all the sockets handles
-    fd_set socketsReady; ///< Set containing handles of the sockets that are ready
-    int    maxSocket;    ///< Maximum socket handle
-    int    socketCount;  ///< Number of socket handles
+    typedef std::map<Socket*, SocketHandle> SocketTable;
+    typedef std::set<Socket*> SocketSet;
+
+    SocketSelectorImpl();
+    SocketSelectorImpl(const SocketSelectorImpl& copy);
+    ~SocketSelectorImpl();
+
+    SocketTable          sockets;      ///< Sockets in the selector, with their handle
+    std::vector<Socket*> ready;        ///< Sockets that were ready after the last wait
+    SocketSet            buffered;     ///< Sockets which reported buffered data (it may have been consumed since)
+    mutable Mutex        bufferedMutex;///< Protects buffered, which is filled by the threads receiving on the sockets
+    std::vector<Socket*> bufferedReady;///< Sockets of buffered which still had data at the last wait
+    SocketSet            sending;      ///< Sockets watched for sending
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    fd_set allSockets;         ///< Set containing all the sockets handles
+    fd_set socketsReady;       ///< Set containing handles of the sockets that are ready
+    fd_set sendingSockets;     ///< Set containing the handles of the sockets watched for sending
+    fd_set socketsReadyToSend; ///< Set containing handles of the sockets that are ready to send
+
+#else
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Flag a socket as ready
+    ///
+    /// \param socket Socket which is ready
+    /// \param handle Handle of the socket
+    /// \param flags  What the socket is ready for
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReady(Socket* socket, SocketHandle handle, Uint8 flags);
+
+    std::vector<Uint8>        readyFlags;   ///< Tells what handles are ready for, indexed by handle
+    std::vector<SocketHandle> readyHandles; ///< Handles flagged as ready, to reset their flag quickly
+    std::vector<pollfd>       pollHandles;  ///< Handles to watch with poll
+    std::vector<Socket*>      pollSockets;  ///< Sockets corresponding to the entries of pollHandles
+    bool                      pollDirty;    ///< Does pollHandles need to be rebuilt?
+
+#endif
+
+#if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+    int                      epoll;  ///< The epoll instance, or -1 to fall back to poll
+    std::vector<epoll_event> events; ///< Events returned by epoll_wait
+
+#endif
+
+private:
+
+    SocketSelectorImpl& operator =(const SocketSelectorImpl&);
 };
 
 
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl()
+{
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    FD_ZERO(&allSockets);
+    FD_ZERO(&socketsReady);
+    FD_ZERO(&sendingSockets);
+    FD_ZERO(&socketsReadyToSend);
+
+#else
+
+    pollDirty = false;
+
+#endif
+
+#if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+    // If epoll is not available, poll will be used instead
+    epoll = epoll_create(1);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl(const SocketSelectorImpl& copy) :
+sockets (copy.sockets),
+ready   (copy.ready),
+sending (copy.sending)
+{
+    {
+        Lock lock(copy.bufferedMutex);
+        buffered = copy.buffered;
+    }
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    allSockets         = copy.allSockets;
+    socketsReady       = copy.socketsReady;
+    sendingSockets     = copy.sendingSockets;
+    socketsReadyToSend = copy.socketsReadyToSend;
+
+#else
+
+    readyFlags   = copy.readyFlags;
+    readyHandles = copy.readyHandles;
+    pollDirty    = true;
+
+#endif
+
+#if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+    // An epoll instance can't be shared, we have to create a new one and register all the sockets again
+    epoll = epoll_create(1);
+    if (epoll != -1)
+    {
+        for (SocketTable::const_iterator it = sockets.begin(); it != sockets.end(); ++it)
+        {
+            epoll_event event = epoll_event();
+            event.events = (sending.find(it->first) != sending.end()) ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+            event.data.ptr = it->first;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, it->second, &event);
+        }
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::~SocketSelectorImpl()
+{
+#if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+    if (epoll != -1)
+        ::close(epoll);
+
+#endif
+}
+
+
+#if !defined(SFML_SYSTEM_WINDOWS)
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::setReady(Socket* socket, SocketHandle handle, Uint8 flags)
+{
+    if (static_cast<std::size_t>(handle) >= readyFlags.size())
+        readyFlags.resize(handle + 1, 0);
+
+    if (!readyFlags[handle])
+    {
+        readyHandles.push_back(handle);
+        ready.push_back(socket);
+    }
+
+    readyFlags[handle] |= flags;
+}
+
+#endif
+
+
 ////////////////////////////////////////////////////////////
 SocketSelector::SocketSelector() :
 m_impl(new SocketSelectorImpl)
 {
-    clear();
+
 }
 
 
@@ -61,13 +233,20 @@ m_impl(new SocketSelectorImpl)
 SocketSelector::SocketSelector(const SocketSelector& copy) :
 m_impl(new SocketSelectorImpl(*copy.m_impl))
 {
-
+    registerSockets();
 }
 
 
 ////////////////////////////////////////////////////////////
 SocketSelector::~SocketSelector()
 {
+    // Make sure that the sockets don't keep a reference to the selector
+    for (SocketSelectorImpl::SocketTable::iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+    {
+        std::vector<SocketSelector*>& selectors = it->first->m_selectors;
+        selectors.erase(std::remove(selectors.begin(), selectors.end(), this), selectors.end());
+    }
+
     delete m_impl;
 }
 
@@ -78,10 +257,19 @@ void SocketSelector::add(Socket& socket)
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
     {
+        // A socket whose handle changed must be registered again
+        SocketSelectorImpl::SocketTable::iterator it = m_impl->sockets.find(&socket);
+        if (it != m_impl->sockets.end())
+        {
+            if (it->second == handle)
+                return;
+
+            remove(socket);
+        }
 
 #if defined(SFML_SYSTEM_WINDOWS)
 
-        if (m_impl->socketCount >= FD_SETSIZE)
+        if (m_impl->sockets.size() >= FD_SETSIZE)
         {
             err() << "The socket can't be added to the selector because the "
                   << "selector is full. This is a limitation of your operating "
@@ -89,27 +277,39 @@ void SocketSelector::add(Socket& socket)
             return;
         }
 
-        if (FD_ISSET(handle, &m_impl->allSockets))
-            return;
-
-        m_impl->socketCount++;
+        FD_SET(handle, &m_impl->allSockets);
 
 #else
 
-        if (handle >= FD_SETSIZE)
+    #if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+        if (m_impl->epoll != -1)
         {
-            err() << "The socket can't be added to the selector because its "
-                  << "ID is too high. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
+            epoll_event event = epoll_event();
+            event.events = EPOLLIN;
+            event.data.ptr = &socket;
+            if ((epoll_ctl(m_impl->epoll, EPOLL_CTL_ADD, handle, &event) == -1) &&
+                ((errno != EEXIST) || (epoll_ctl(m_impl->epoll, EPOLL_CTL_MOD, handle, &event) == -1)))
+            {
+                err() << "The socket can't be added to the selector (epoll_ctl failed)" << std::endl;
+                return;
+            }
         }
 
-        // SocketHandle is an int in POSIX
-        m_impl->maxSocket = std::max(m_impl->maxSocket, handle);
+    #endif
+
+        m_impl->pollDirty = true;
 
 #endif
 
-        FD_SET(handle, &m_impl->allSockets);
+        m_impl->sockets[&socket] = handle;
+        socket.m_selectors.push_back(this);
+
+        if (socket.hasBufferedData())
+        {
+            Lock lock(m_impl->bufferedMutex);
+            m_impl->buffered.insert(&socket);
+        }
     }
 }
 
@@ -117,57 +317,209 @@ void SocketSelector::add(Socket& socket)
 ////////////////////////////////////////////////////////////
 void SocketSelector::remove(Socket& socket)
 {
-    SocketHandle handle = socket.getHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
+    SocketSelectorImpl::SocketTable::iterator it = m_impl->sockets.find(&socket);
+    if (it == m_impl->sockets.end())
+        return;
+
+    SocketHandle handle = it->second;
+    m_impl->sockets.erase(it);
+    m_impl->sending.erase(&socket);
+    m_impl->ready.erase(std::remove(m_impl->ready.begin(), m_impl->ready.end(), &socket), m_impl->ready.end());
+    socket.m_selectors.erase(std::remove(socket.m_selectors.begin(), socket.m_selectors.end(), this), socket.m_selectors.end());
+
     {
+        Lock lock(m_impl->bufferedMutex);
+        m_impl->buffered.erase(&socket);
+    }
 
 #if defined(SFML_SYSTEM_WINDOWS)
 
-        if (!FD_ISSET(handle, &m_impl->allSockets))
-            return;
-
-        m_impl->socketCount--;
+    FD_CLR(handle, &m_impl->allSockets);
+    FD_CLR(handle, &m_impl->socketsReady);
+    FD_CLR(handle, &m_impl->sendingSockets);
+    FD_CLR(handle, &m_impl->socketsReadyToSend);
 
 #else
 
-        if (handle >= FD_SETSIZE)
-            return;
+    #if defined(SFML_SOCKETSELECTOR_EPOLL)
 
-#endif
+        // If the socket was closed, the system has already removed it
+        if ((m_impl->epoll != -1) && (socket.getHandle() == handle))
+        {
+            epoll_event event = epoll_event();
+            epoll_ctl(m_impl->epoll, EPOLL_CTL_DEL, handle, &event);
+        }
 
-        FD_CLR(handle, &m_impl->allSockets);
-        FD_CLR(handle, &m_impl->socketsReady);
-    }
+    #endif
+
+    if (static_cast<std::size_t>(handle) < m_impl->readyFlags.size())
+        m_impl->readyFlags[handle] = 0;
+
+    m_impl->pollDirty = true;
+
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::clear()
 {
-    FD_ZERO(&m_impl->allSockets);
-    FD_ZERO(&m_impl->socketsReady);
+    while (!m_impl->sockets.empty())
+        remove(*m_impl->sockets.begin()->first);
 
-    m_impl->maxSocket = 0;
-    m_impl->socketCount = 0;
+    m_impl->ready.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
+    // Sockets with buffered data are ready, whatever the system says;
+    // in this case we just poll the other sockets, without waiting.
+    // The sockets report themselves when they buffer data, so we only
+    // have to forget the ones whose buffer was consumed since then.
+    // The set is filled by the threads receiving on the sockets, so it
+    // is copied under its lock and the copy is used for the rest of the wait
+    m_impl->bufferedReady.clear();
+    {
+        Lock lock(m_impl->bufferedMutex);
+        for (SocketSelectorImpl::SocketSet::iterator it = m_impl->buffered.begin(); it != m_impl->buffered.end(); )
+        {
+            if ((*it)->hasBufferedData())
+                m_impl->bufferedReady.push_back(*it++);
+            else
+                m_impl->buffered.erase(it++);
+        }
+    }
+    bool buffered = !m_impl->bufferedReady.empty();
+
+    m_impl->ready.clear();
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
     // Setup the timeout
     timeval time;
-    time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
-    time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
+    time.tv_sec  = buffered ? 0 : static_cast<long>(timeout.asMicroseconds() / 1000000);
+    time.tv_usec = buffered ? 0 : static_cast<long>(timeout.asMicroseconds() % 1000000);
 
-    // Initialize the set that will contain the sockets that are ready
+    // Initialize the sets that will contain the sockets that are ready
     m_impl->socketsReady = m_impl->allSockets;
+    m_impl->socketsReadyToSend = m_impl->sendingSockets;
 
-    // Wait until one of the sockets is ready for reading, or timeout is reached
+    // Wait until one of the sockets is ready for reading (or writing if requested), or timeout is reached
     // The first parameter is ignored on Windows
-    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    int count = select(0, &m_impl->socketsReady, &m_impl->socketsReadyToSend, NULL, (buffered || (timeout != Time::Zero)) ? &time : NULL);
+
+    // Collect the sockets that are ready
+    if (count > 0)
+    {
+        for (SocketSelectorImpl::SocketTable::const_iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+        {
+            if (FD_ISSET(it->second, &m_impl->socketsReady) || FD_ISSET(it->second, &m_impl->socketsReadyToSend))
+                m_impl->ready.push_back(it->first);
+        }
+    }
+
+    // Add the sockets that have buffered data
+    for (std::vector<Socket*>::const_iterator it = m_impl->bufferedReady.begin(); it != m_impl->bufferedReady.end(); ++it)
+    {
+        SocketHandle handle = m_impl->sockets[*it];
+        if (!FD_ISSET(handle, &m_impl->socketsReady))
+        {
+            if (!FD_ISSET(handle, &m_impl->socketsReadyToSend))
+                m_impl->ready.push_back(*it);
+
+            FD_SET(handle, &m_impl->socketsReady);
+        }
+    }
+
+#else
+
+    // Reset the flags of the previous wait
+    for (std::vector<SocketHandle>::const_iterator it = m_impl->readyHandles.begin(); it != m_impl->readyHandles.end(); ++it)
+    {
+        if (static_cast<std::size_t>(*it) < m_impl->readyFlags.size())
+            m_impl->readyFlags[*it] = 0;
+    }
+    m_impl->readyHandles.clear();
+
+    // Convert the timeout to milliseconds, rounded up so that we don't spin for short timeouts
+    int milliseconds = -1;
+    if (buffered)
+        milliseconds = 0;
+    else if (timeout != Time::Zero)
+        milliseconds = static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+
+    #if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+    if (m_impl->epoll != -1)
+    {
+        // Wait until one of the sockets is ready for reading, or timeout is reached
+        m_impl->events.resize(std::max<std::size_t>(m_impl->sockets.size(), 1));
+        int count = epoll_wait(m_impl->epoll, &m_impl->events[0], static_cast<int>(m_impl->events.size()), milliseconds);
 
-    return count > 0;
+        for (int i = 0; i < count; ++i)
+        {
+            Socket* socket = static_cast<Socket*>(m_impl->events[i].data.ptr);
+            Uint32 events = m_impl->events[i].events;
+
+            Uint8 flags = 0;
+            if (events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                flags |= readyToReceive;
+            if (events & (EPOLLOUT | EPOLLERR))
+                flags |= readyToSend;
+
+            m_impl->setReady(socket, m_impl->sockets[socket], flags);
+        }
+    }
+    else
+
+    #endif
+
+    {
+        // Rebuild the array of handles if sockets were added or removed
+        if (m_impl->pollDirty)
+        {
+            m_impl->pollHandles.clear();
+            m_impl->pollSockets.clear();
+            for (SocketSelectorImpl::SocketTable::const_iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+            {
+                pollfd handle;
+                handle.fd = it->second;
+                handle.events = (m_impl->sending.find(it->first) != m_impl->sending.end()) ? (POLLIN | POLLOUT) : POLLIN;
+                handle.revents = 0;
+                m_impl->pollHandles.push_back(handle);
+                m_impl->pollSockets.push_back(it->first);
+            }
+            m_impl->pollDirty = false;
+        }
+
+        // Wait until one of the sockets is ready for reading, or timeout is reached
+        pollfd* handles = m_impl->pollHandles.empty() ? NULL : &m_impl->pollHandles[0];
+        int count = poll(handles, static_cast<nfds_t>(m_impl->pollHandles.size()), milliseconds);
+
+        for (std::size_t i = 0; (count > 0) && (i < m_impl->pollHandles.size()); ++i)
+        {
+            short events = m_impl->pollHandles[i].revents;
+
+            Uint8 flags = 0;
+            if (events & (POLLIN | POLLHUP | POLLERR))
+                flags |= readyToReceive;
+            if (events & (POLLOUT | POLLERR))
+                flags |= readyToSend;
+
+            if (flags)
+                m_impl->setReady(m_impl->pollSockets[i], m_impl->pollHandles[i].fd, flags);
+        }
+    }
+
+    // Add the sockets that have buffered data, the system doesn't know about it
+    for (std::vector<Socket*>::const_iterator it = m_impl->bufferedReady.begin(); it != m_impl->bufferedReady.end(); ++it)
+        m_impl->setReady(*it, m_impl->sockets[*it], readyToReceive);
+
+#endif
+
+    return !m_impl->ready.empty();
 }
 
 
@@ -177,15 +529,83 @@ bool SocketSelector::isReady(Socket& socket) const
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
     {
+        if (socket.hasBufferedData())
+            return true;
 
-#if !defined(SFML_SYSTEM_WINDOWS)
+#if defined(SFML_SYSTEM_WINDOWS)
+
+        return FD_ISSET(handle, &m_impl->socketsReady) != 0;
 
-        if (handle >= FD_SETSIZE)
-            return false;
+#else
+
+        return (static_cast<std::size_t>(handle) < m_impl->readyFlags.size()) && ((m_impl->readyFlags[handle] & readyToReceive) != 0);
 
 #endif
+    }
 
-        return FD_ISSET(handle, &m_impl->socketsReady) != 0;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::setSendMonitoring(Socket& socket, bool enabled)
+{
+    SocketSelectorImpl::SocketTable::iterator it = m_impl->sockets.find(&socket);
+    if (it == m_impl->sockets.end())
+        return;
+
+    // Nothing to do if the state doesn't change
+    if (enabled == (m_impl->sending.find(&socket) != m_impl->sending.end()))
+        return;
+
+    if (enabled)
+        m_impl->sending.insert(&socket);
+    else
+        m_impl->sending.erase(&socket);
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    if (enabled)
+        FD_SET(it->second, &m_impl->sendingSockets);
+    else
+        FD_CLR(it->second, &m_impl->sendingSockets);
+
+#else
+
+    #if defined(SFML_SOCKETSELECTOR_EPOLL)
+
+        if (m_impl->epoll != -1)
+        {
+            epoll_event event = epoll_event();
+            event.events = enabled ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+            event.data.ptr = &socket;
+            if (epoll_ctl(m_impl->epoll, EPOLL_CTL_MOD, it->second, &event) == -1)
+                err() << "Failed to change the events watched on a socket (epoll_ctl failed)" << std::endl;
+        }
+
+    #endif
+
+    m_impl->pollDirty = true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketSelector::isReadyToSend(Socket& socket) const
+{
+    SocketHandle handle = socket.getHandle();
+    if (handle != priv::SocketImpl::invalidSocket())
+    {
+#if defined(SFML_SYSTEM_WINDOWS)
+
+        return FD_ISSET(handle, &m_impl->socketsReadyToSend) != 0;
+
+#else
+
+        return (static_cast<std::size_t>(handle) < m_impl->readyFlags.size()) && ((m_impl->readyFlags[handle] & readyToSend) != 0);
+
+#endif
     }
 
     return false;
@@ -193,13 +613,51 @@ bool SocketSelector::isReady(Socket& socket) const
 
 
 ////////////////////////////////////////////////////////////
-SocketSelector& SocketSelector::operator =(const SocketSelector& right)
+SocketSelector::ReadyIterator SocketSelector::beginReady() const
 {
-    SocketSelector temp(right);
+    return m_impl->ready.begin();
+}
 
-    std::swap(m_impl, temp.m_impl);
+
+////////////////////////////////////////////////////////////
+SocketSelector::ReadyIterator SocketSelector::endReady() const
+{
+    return m_impl->ready.end();
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector& SocketSelector::operator =(const SocketSelector& right)
+{
+    if (this != &right)
+    {
+        // The sockets know which selectors watch them, so we can't just
+        // swap the implementations: unregister from the current sockets,
+        // and register to the new ones
+        SocketSelectorImpl* impl = new SocketSelectorImpl(*right.m_impl);
+        clear();
+        delete m_impl;
+        m_impl = impl;
+        registerSockets();
+    }
 
     return *this;
 }
 
+
+////////////////////////////////////////////////////////////
+void SocketSelector::registerSockets()
+{
+    for (SocketSelectorImpl::SocketTable::iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+        it->first->m_selectors.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::addBufferedSocket(Socket& socket)
+{
+    Lock lock(m_impl->bufferedMutex);
+    m_impl->buffered.insert(&socket);
+}
+
 } // namespace sf
@@ -46,13 +46,19 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Size of the buffer used to read ahead the incoming packets
+    const std::size_t receiveBufferSize = 16384;
 }
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket         (Tcp),
+m_receiveBegin (0),
+m_receiveEnd   (0),
+m_maxPacketSize(0)
 {
 
 }
@@ -211,8 +217,11 @@ void TcpSocket::disconnect()
     // Close the socket
     close();
 
-    // Reset the pending packet data
+    // Reset the pending packet data and release its memory, and drop the data read ahead
     m_pendingPacket = PendingPacket();
+    std::vector<char>().swap(m_pendingPacket.Data);
+    m_receiveBegin = 0;
+    m_receiveEnd = 0;
 }
 
 
@@ -274,6 +283,15 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
+    // Give the data which was already read ahead first
+    if (m_receiveBegin < m_receiveEnd)
+    {
+        received = std::min(size, m_receiveEnd - m_receiveBegin);
+        std::memcpy(data, &m_receiveBuffer[m_receiveBegin], received);
+        m_receiveBegin += received;
+        return Done;
+    }
+
     // Receive a chunk of bytes
     int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
 
@@ -297,45 +315,144 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(Packet& packet)
 {
-    // TCP is a stream protocol, it doesn't preserve messages boundaries.
-    // This means that we have to send the packet size first, so that the
-    // receiver knows the actual end of the packet in the data stream.
+    std::size_t sent;
+
+    return sendBatch(&packet, 1, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::sendBatch(Packet* packets, std::size_t count)
+{
+    if (!isBlocking())
+        err() << "Warning: Partial sends might not be handled properly." << std::endl;
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    std::size_t sent;
 
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    return sendBatch(packets, count, sent);
+}
 
-    // First convert the packet size to network byte order
-    Uint32 packetSize = htonl(static_cast<Uint32>(size));
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::sendBatch(Packet* packets, std::size_t count, std::size_t& sent)
+{
+    // TCP is a stream protocol, it doesn't preserve messages boundaries.
+    // This means that we have to send the packet size first, so that the
+    // receiver knows the actual end of the packet in the data stream.
 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+    // The size and the data of each packet are sent together with a single
+    // scatter/gather call, without copying them into an intermediate block.
+    // This avoids partial sends between the size and the data, which could
+    // cause data corruption on the receiving end.
 
-    // Send the data block
-    std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
+    sent = 0;
 
-    // In the case of a partial send, record the location to resume from
-    if (status == Partial)
+    if (!packets && (count > 0))
     {
-        packet.m_sendPos += sent;
+        err() << "Cannot send packets over the network (invalid packet array)" << std::endl;
+        return Error;
     }
-    else if (status == Done)
+
+    // Packets are sent by chunks, so that the buffers fit in the stack
+    const std::size_t maxChunkSize = priv::SocketImpl::MaxBuffers / 2;
+    bool anythingSent = false;
+    while (sent < count)
     {
-        packet.m_sendPos = 0;
+        std::size_t chunkSize = std::min(count - sent, maxChunkSize);
+        priv::SocketImpl::Buffer buffers[priv::SocketImpl::MaxBuffers];
+        Uint32 packetSizes[maxChunkSize];
+        std::size_t blockSizes[maxChunkSize];
+        std::size_t bufferCount = 0;
+
+        // Gather the remaining bytes of each packet: the size first, in network
+        // byte order, then the data (skipping what a previous call already sent)
+        for (std::size_t i = 0; i < chunkSize; ++i)
+        {
+            Packet& packet = packets[sent + i];
+
+            std::size_t size = 0;
+            const char* data = static_cast<const char*>(packet.onSend(size));
+            packetSizes[i] = htonl(static_cast<Uint32>(size));
+            blockSizes[i] = sizeof(Uint32) + size;
+
+            std::size_t position = packet.m_sendPos;
+            if (position < sizeof(Uint32))
+            {
+                buffers[bufferCount].data = reinterpret_cast<const char*>(&packetSizes[i]) + position;
+                buffers[bufferCount].size = sizeof(Uint32) - position;
+                ++bufferCount;
+                position = 0;
+            }
+            else
+            {
+                position -= sizeof(Uint32);
+            }
+
+            if (position < size)
+            {
+                buffers[bufferCount].data = data + position;
+                buffers[bufferCount].size = size - position;
+                ++bufferCount;
+            }
+        }
+
+        // Send the buffers, until all of them are sent or an error occurs
+        Status status = Done;
+        std::size_t first = 0;
+        std::size_t packet = sent;
+        while (first < bufferCount)
+        {
+            int result = priv::SocketImpl::sendBuffers(getHandle(), &buffers[first], bufferCount - first, flags);
+            if (result < 0)
+            {
+                status = priv::SocketImpl::getErrorStatus();
+                break;
+            }
+
+            anythingSent = anythingSent || (result > 0);
+
+            // Skip the buffers that were completely sent, and move into the one that was partially sent
+            std::size_t bytes = static_cast<std::size_t>(result);
+            while ((first < bufferCount) && (bytes >= buffers[first].size))
+            {
+                bytes -= buffers[first].size;
+                ++first;
+            }
+            if (first < bufferCount)
+            {
+                buffers[first].data += bytes;
+                buffers[first].size -= bytes;
+            }
+
+            // Record the progress of the packets, so that sending can be resumed
+            bytes = static_cast<std::size_t>(result);
+            while (bytes > 0)
+            {
+                std::size_t remaining = blockSizes[packet - sent] - packets[packet].m_sendPos;
+                if (bytes < remaining)
+                {
+                    packets[packet].m_sendPos += bytes;
+                    break;
+                }
+
+                bytes -= remaining;
+                packets[packet].m_sendPos = 0;
+                ++packet;
+            }
+        }
+
+        sent = packet;
+
+        if (status != Done)
+        {
+            if ((status == NotReady) && anythingSent)
+                return Partial;
+
+            return status;
+        }
     }
 
-    return status;
+    return Done;
 }
 
 
@@ -346,65 +463,165 @@ Socket::Status TcpSocket::receive(Packet& packet)
     packet.clear();
 
     // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
-    std::size_t received = 0;
-    if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+    // (even a 4 byte variable may be received in more than one call)
+    while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
     {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+        if (m_receiveBegin == m_receiveEnd)
         {
-            char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
-            m_pendingPacket.SizeReceived += received;
-
+            Status status = fillReceiveBuffer();
             if (status != Done)
                 return status;
         }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
+        std::size_t count = std::min(sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, m_receiveEnd - m_receiveBegin);
+        char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
+        std::memcpy(data, &m_receiveBuffer[m_receiveBegin], count);
+        m_pendingPacket.SizeReceived += count;
+        m_receiveBegin += count;
     }
-    else
+
+    // The packet size has been fully received (possibly in a previous call)
+    std::size_t packetSize = ntohl(m_pendingPacket.Size);
+
+    // Refuse packets that are too big, they would make us allocate
+    // as much memory as the remote peer wants; the rest of the stream
+    // can't be trusted anymore, so the connection is closed
+    if ((m_maxPacketSize > 0) && (packetSize > m_maxPacketSize))
+    {
+        err() << "Received a packet bigger than the maximum packet size (" << packetSize << " bytes, "
+              << "maximum is " << m_maxPacketSize << " bytes), disconnecting" << std::endl;
+        disconnect();
+        return Error;
+    }
+
+    if (m_pendingPacket.DataReceived == 0)
     {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
+        // If the whole packet is already in the read-ahead buffer, we can give it to the user packet directly
+        if (m_receiveEnd - m_receiveBegin >= packetSize)
+        {
+            if (packetSize > 0)
+                packet.onReceive(&m_receiveBuffer[m_receiveBegin], packetSize);
+
+            m_receiveBegin += packetSize;
+            m_pendingPacket.Size = 0;
+            m_pendingPacket.SizeReceived = 0;
+
+            return Done;
+        }
+
+        m_pendingPacket.Data.resize(packetSize);
     }
 
     // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    while (m_pendingPacket.DataReceived < packetSize)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
-        if (status != Done)
-            return status;
+        std::size_t remaining = packetSize - m_pendingPacket.DataReceived;
+        char* data = &m_pendingPacket.Data[0] + m_pendingPacket.DataReceived;
+
+        if (m_receiveBegin < m_receiveEnd)
+        {
+            // First consume the data which was already read ahead
+            std::size_t count = std::min(remaining, m_receiveEnd - m_receiveBegin);
+            std::memcpy(data, &m_receiveBuffer[m_receiveBegin], count);
+            m_pendingPacket.DataReceived += count;
+            m_receiveBegin += count;
+        }
+        else if (remaining >= m_receiveBuffer.size())
+        {
+            // Big packet: receive directly into its storage, there's no point in reading ahead
+            int sizeReceived = recv(getHandle(), data, static_cast<int>(remaining), flags);
+            if (sizeReceived <= 0)
+                return (sizeReceived == 0) ? Disconnected : priv::SocketImpl::getErrorStatus();
 
-        // Append it into the packet
-        if (received > 0)
+            m_pendingPacket.DataReceived += static_cast<std::size_t>(sizeReceived);
+        }
+        else
         {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
+            // Small amount of data: read ahead, the next packets may come with it
+            Status status = fillReceiveBuffer();
+            if (status != Done)
+                return status;
         }
     }
 
     // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
+    if (packetSize > 0)
+        packet.onReceive(&m_pendingPacket.Data[0], packetSize);
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Clear the pending packet data, but keep its memory for the next packets
+    m_pendingPacket.Size = 0;
+    m_pendingPacket.SizeReceived = 0;
+    m_pendingPacket.DataReceived = 0;
+    m_pendingPacket.Data.clear();
 
     return Done;
 }
 
 
+////////////////////////////////////////////////////////////
+void TcpSocket::setMaxPacketSize(std::size_t size)
+{
+    m_maxPacketSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getMaxPacketSize() const
+{
+    return m_maxPacketSize;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::hasBufferedData() const
+{
+    return m_receiveBegin < m_receiveEnd;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::fillReceiveBuffer()
+{
+    // Allocate the buffer the first time it is needed
+    if (m_receiveBuffer.empty())
+        m_receiveBuffer.resize(receiveBufferSize);
+
+    // Move the unread bytes to the beginning of the buffer, to make room after them
+    if (m_receiveBegin > 0)
+    {
+        if (m_receiveBegin < m_receiveEnd)
+            std::memmove(&m_receiveBuffer[0], &m_receiveBuffer[m_receiveBegin], m_receiveEnd - m_receiveBegin);
+
+        m_receiveEnd -= m_receiveBegin;
+        m_receiveBegin = 0;
+    }
+
+    // Receive as many bytes as possible
+    char* data = &m_receiveBuffer[0] + m_receiveEnd;
+    int sizeReceived = recv(getHandle(), data, static_cast<int>(m_receiveBuffer.size() - m_receiveEnd), flags);
+
+    if (sizeReceived > 0)
+    {
+        m_receiveEnd += static_cast<std::size_t>(sizeReceived);
+        onDataBuffered();
+        return Done;
+    }
+    else if (sizeReceived == 0)
+    {
+        return Socket::Disconnected;
+    }
+    else
+    {
+        return priv::SocketImpl::getErrorStatus();
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 TcpSocket::PendingPacket::PendingPacket() :
 Size        (0),
 SizeReceived(0),
+DataReceived(0),
 Data        ()
 {
 
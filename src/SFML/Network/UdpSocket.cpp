@@ -26,11 +26,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/UdpSocket.hpp>
+#include <SFML/Network/DatagramBatch.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstring>
 
 
 namespace sf
@@ -81,6 +83,24 @@ Socket::Status UdpSocket::bind(unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::bind(unsigned short port, const IpAddress& address)
+{
+    // Create the internal socket if it doesn't exist
+    create();
+
+    // Bind the socket
+    sockaddr_in addr = priv::SocketImpl::createAddress(address.toInteger(), port);
+    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1)
+    {
+        err() << "Failed to bind socket to port " << port << " on " << address << std::endl;
+        return Error;
+    }
+
+    return Done;
+}
+
+
 ////////////////////////////////////////////////////////////
 void UdpSocket::unbind()
 {
@@ -190,4 +210,108 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::sendBatch(const DatagramBatch& batch)
+{
+    if (!isBlocking())
+        err() << "Warning: Partial sends might not be handled properly." << std::endl;
+
+    std::size_t sent;
+
+    return sendBatch(batch, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::sendBatch(const DatagramBatch& batch, std::size_t& sent)
+{
+    // Create the internal socket if it doesn't exist
+    create();
+
+    sent = 0;
+
+    while (sent < batch.getCount())
+    {
+        // Describe the next datagrams for the system
+        priv::SocketImpl::Message messages[priv::SocketImpl::MaxMessages];
+        std::size_t count = std::min<std::size_t>(batch.getCount() - sent, priv::SocketImpl::MaxMessages);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t index = sent + i;
+            messages[i].data    = const_cast<char*>(static_cast<const char*>(batch.getData(index)));
+            messages[i].size    = batch.getDataSize(index);
+            messages[i].address = priv::SocketImpl::createAddress(batch.getRemoteAddress(index).toInteger(), batch.getRemotePort(index));
+        }
+
+        int result = priv::SocketImpl::sendMessages(getHandle(), messages, count);
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            if ((status == NotReady) && (sent > 0))
+                return Partial;
+
+            return status;
+        }
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receiveBatch(DatagramBatch& batch)
+{
+    batch.clear();
+
+    while (batch.m_datagrams.size() < batch.getCapacity())
+    {
+        // Give the system the free slots of the batch
+        priv::SocketImpl::Message messages[priv::SocketImpl::MaxMessages];
+        std::size_t first = batch.m_datagrams.size();
+        std::size_t count = std::min<std::size_t>(batch.getCapacity() - first, priv::SocketImpl::MaxMessages);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            messages[i].data    = batch.getBuffer(first + i);
+            messages[i].size    = batch.getMaxDatagramSize();
+            messages[i].address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+        }
+
+        // Only the first datagram is waited for
+        int result = priv::SocketImpl::receiveMessages(getHandle(), messages, count, first == 0);
+        if (result < 0)
+            return first == 0 ? priv::SocketImpl::getErrorStatus() : Done;
+
+        for (int i = 0; i < result; ++i)
+        {
+            // Truncated datagrams are useless, drop them
+            if (messages[i].truncated)
+            {
+                err() << "Dropped a datagram bigger than the maximum datagram size of the batch ("
+                      << batch.getMaxDatagramSize() << " bytes)" << std::endl;
+                continue;
+            }
+
+            // Move the data to the right slot if a previous datagram was dropped
+            char* slot = batch.getBuffer(batch.m_datagrams.size());
+            if (messages[i].data != slot)
+                std::memcpy(slot, messages[i].data, messages[i].size);
+
+            DatagramBatch::Datagram datagram;
+            datagram.size    = messages[i].size;
+            datagram.address = IpAddress(ntohl(messages[i].address.sin_addr.s_addr));
+            datagram.port    = ntohs(messages[i].address.sin_port);
+            batch.m_datagrams.push_back(datagram);
+        }
+
+        // Stop if there's nothing left to receive (unless all the datagrams
+        // were dropped, in which case we have to wait for another one)
+        if ((static_cast<std::size_t>(result) < count) && !batch.m_datagrams.empty())
+            break;
+    }
+
+    return Done;
+}
+
 } // namespace sf
@@ -99,6 +99,134 @@ Socket::Status SocketImpl::getErrorStatus()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, const Buffer* buffers, std::size_t count, int flags)
+{
+    if (count > MaxBuffers)
+        count = MaxBuffers;
+
+    iovec vectors[MaxBuffers];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i].iov_base = const_cast<char*>(buffers[i].data);
+        vectors[i].iov_len  = buffers[i].size;
+    }
+
+    // sendmsg is used rather than writev, so that the flags apply
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = vectors;
+    message.msg_iovlen = count;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendMessages(SocketHandle sock, const Message* messages, std::size_t count)
+{
+    if (count > MaxMessages)
+        count = MaxMessages;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Linux can send all the datagrams with a single system call
+    iovec vectors[MaxMessages];
+    mmsghdr headers[MaxMessages];
+    std::memset(headers, 0, count * sizeof(mmsghdr));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i].iov_base = messages[i].data;
+        vectors[i].iov_len  = messages[i].size;
+        headers[i].msg_hdr.msg_iov     = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen  = 1;
+        headers[i].msg_hdr.msg_name    = const_cast<sockaddr_in*>(&messages[i].address);
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    return sendmmsg(sock, headers, static_cast<unsigned int>(count), 0);
+
+#else
+
+    std::size_t sent = 0;
+    for (; sent < count; ++sent)
+    {
+        const Message& message = messages[sent];
+        if (sendto(sock, message.data, message.size, 0, reinterpret_cast<const sockaddr*>(&message.address), sizeof(sockaddr_in)) < 0)
+            break;
+    }
+
+    return sent > 0 ? static_cast<int>(sent) : -1;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::receiveMessages(SocketHandle sock, Message* messages, std::size_t count, bool wait)
+{
+    if (count > MaxMessages)
+        count = MaxMessages;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Linux can receive all the available datagrams with a single system call
+    iovec vectors[MaxMessages];
+    mmsghdr headers[MaxMessages];
+    std::memset(headers, 0, count * sizeof(mmsghdr));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i].iov_base = messages[i].data;
+        vectors[i].iov_len  = messages[i].size;
+        headers[i].msg_hdr.msg_iov     = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen  = 1;
+        headers[i].msg_hdr.msg_name    = &messages[i].address;
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    int received = recvmmsg(sock, headers, static_cast<unsigned int>(count), wait ? MSG_WAITFORONE : MSG_DONTWAIT, NULL);
+
+    for (int i = 0; i < received; ++i)
+    {
+        messages[i].size = headers[i].msg_len;
+        messages[i].truncated = (headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    }
+
+    return received;
+
+#else
+
+    std::size_t received = 0;
+    for (; received < count; ++received)
+    {
+        // Only the first datagram may be waited for
+        // recvmsg is used rather than recvfrom to know whether the datagram was truncated
+        Message& message = messages[received];
+        iovec vector;
+        vector.iov_base = message.data;
+        vector.iov_len  = message.size;
+        msghdr header;
+        std::memset(&header, 0, sizeof(header));
+        header.msg_iov     = &vector;
+        header.msg_iovlen  = 1;
+        header.msg_name    = &message.address;
+        header.msg_namelen = sizeof(sockaddr_in);
+
+        int flags = (wait && (received == 0)) ? 0 : MSG_DONTWAIT;
+        ssize_t size = recvmsg(sock, &header, flags);
+        if (size < 0)
+            break;
+
+        message.size = static_cast<std::size_t>(size);
+        message.truncated = (header.msg_flags & MSG_TRUNC) != 0;
+    }
+
+    return received > 0 ? static_cast<int>(received) : -1;
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
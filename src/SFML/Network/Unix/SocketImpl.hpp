@@ -35,6 +35,7 @@
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 
@@ -56,6 +57,40 @@ public:
     ////////////////////////////////////////////////////////////
     typedef socklen_t AddrLength;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Memory block to send with sendBuffers
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
+    {
+        const char* data; ///< Pointer to the bytes to send
+        std::size_t size; ///< Number of bytes to send
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Maximum number of buffers sent by a single call to sendBuffers
+    ///
+    ////////////////////////////////////////////////////////////
+    enum {MaxBuffers = 256};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram to send with sendMessages or to fill with receiveMessages
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Message
+    {
+        char*       data;      ///< Bytes of the datagram
+        std::size_t size;      ///< Size of the datagram (size of the buffer before receiving)
+        sockaddr_in address;   ///< Address of the peer
+        bool        truncated; ///< Was the received datagram bigger than the buffer?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Maximum number of messages handled by a single call to sendMessages or receiveMessages
+    ///
+    ////////////////////////////////////////////////////////////
+    enum {MaxMessages = 64};
+
     ////////////////////////////////////////////////////////////
     /// \brief Create an internal sockaddr_in address
     ///
@@ -99,6 +134,56 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several memory blocks with a single system call
+    ///
+    /// At most MaxBuffers buffers are sent; like ::send, the
+    /// function may send less bytes than requested.
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Array of buffers to send, in order
+    /// \param count   Number of buffers in the array
+    /// \param flags   Flags to pass to the system function
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendBuffers(SocketHandle sock, const Buffer* buffers, std::size_t count, int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams with as few system calls as possible
+    ///
+    /// At most MaxMessages messages are sent; the function stops
+    /// at the first message which can't be sent.
+    ///
+    /// \param sock     Handle of the socket
+    /// \param messages Array of messages to send, in order
+    /// \param count    Number of messages in the array
+    ///
+    /// \return Number of messages sent, or -1 if none could be sent
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendMessages(SocketHandle sock, const Message* messages, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several datagrams with as few system calls as possible
+    ///
+    /// At most MaxMessages messages are received. If the socket is
+    /// in blocking mode and \a wait is true, the function waits for
+    /// the first message, the other ones are only received if they
+    /// are already available. Datagrams bigger than their message's
+    /// buffer are truncated, and flagged as such.
+    ///
+    /// \param sock     Handle of the socket
+    /// \param messages Array of messages to fill
+    /// \param count    Number of messages in the array
+    /// \param wait     Wait for the first message if the socket is blocking?
+    ///
+    /// \return Number of messages received, or -1 if none could be received
+    ///
+    ////////////////////////////////////////////////////////////
+    static int receiveMessages(SocketHandle sock, Message* messages, std::size_t count, bool wait);
 };
 
 } // namespace priv
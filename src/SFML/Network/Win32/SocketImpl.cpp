@@ -86,6 +86,88 @@ Socket::Status SocketImpl::getErrorStatus()
 }
 
 
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, const Buffer* buffers, std::size_t count, int flags)
+{
+    if (count > MaxBuffers)
+        count = MaxBuffers;
+
+    WSABUF vectors[MaxBuffers];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i].buf = const_cast<char*>(buffers[i].data);
+        vectors[i].len = static_cast<u_long>(buffers[i].size);
+    }
+
+    DWORD sent = 0;
+    if (WSASend(sock, vectors, static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendMessages(SocketHandle sock, const Message* messages, std::size_t count)
+{
+    if (count > MaxMessages)
+        count = MaxMessages;
+
+    std::size_t sent = 0;
+    for (; sent < count; ++sent)
+    {
+        const Message& message = messages[sent];
+        if (sendto(sock, message.data, static_cast<int>(message.size), 0, reinterpret_cast<const sockaddr*>(&message.address), sizeof(sockaddr_in)) == SOCKET_ERROR)
+            break;
+    }
+
+    return sent > 0 ? static_cast<int>(sent) : -1;
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::receiveMessages(SocketHandle sock, Message* messages, std::size_t count, bool wait)
+{
+    if (count > MaxMessages)
+        count = MaxMessages;
+
+    std::size_t received = 0;
+    for (; received < count; ++received)
+    {
+        // Only the first datagram may be waited for, so stop as soon as
+        // there's nothing left to read (we can't pass a non-blocking flag)
+        if (!wait || (received > 0))
+        {
+            u_long available = 0;
+            if ((ioctlsocket(sock, FIONREAD, &available) == SOCKET_ERROR) || (available == 0))
+            {
+                if (received == 0)
+                    WSASetLastError(WSAEWOULDBLOCK);
+                break;
+            }
+        }
+
+        Message& message = messages[received];
+        AddrLength addressSize = sizeof(sockaddr_in);
+        int size = recvfrom(sock, message.data, static_cast<int>(message.size), 0, reinterpret_cast<sockaddr*>(&message.address), &addressSize);
+        message.truncated = false;
+        if (size == SOCKET_ERROR)
+        {
+            // Windows reports truncated datagrams as errors
+            if (WSAGetLastError() != WSAEMSGSIZE)
+                break;
+
+            size = static_cast<int>(message.size);
+            message.truncated = true;
+        }
+
+        message.size = static_cast<std::size_t>(size);
+    }
+
+    return received > 0 ? static_cast<int>(received) : -1;
+}
+
+
 ////////////////////////////////////////////////////////////
 // Windows needs some initialization and cleanup to get
 // sockets working properly... so let's create a class that will
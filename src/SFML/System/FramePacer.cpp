@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FramePacer.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FramePacer::Stats::Stats() :
+cpuTime        (Time::Zero),
+presentTime    (Time::Zero),
+frameTime      (Time::Zero),
+frameCount     (0),
+missedDeadlines(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer::FramePacer() :
+m_frameTimeLimit(Time::Zero),
+m_spinThreshold (milliseconds(1)),
+m_timestep      (Time::Zero),
+m_maxSteps      (8)
+{
+    restart();
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFrameTimeLimit(Time limit)
+{
+    m_frameTimeLimit = std::max(limit, Time::Zero);
+
+    // Start a new schedule from the current frame
+    m_deadline = m_frameStart + m_frameTimeLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getFrameTimeLimit() const
+{
+    return m_frameTimeLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setSpinThreshold(Time threshold)
+{
+    m_spinThreshold = std::max(threshold, Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::restart()
+{
+    m_clock.restart();
+
+    m_frameStart = Time::Zero;
+    m_presentStart = microseconds(-1);
+    m_deadline = m_frameTimeLimit;
+    m_stats = Stats();
+    m_lastUpdate = Time::Zero;
+    m_accumulator = Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::beginPresent()
+{
+    m_presentStart = m_clock.getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::endFrame()
+{
+    Time now = m_clock.getElapsedTime();
+
+    // Split the frame between CPU work and presentation
+    if (m_presentStart >= m_frameStart)
+    {
+        m_stats.cpuTime = m_presentStart - m_frameStart;
+        m_stats.presentTime = now - m_presentStart;
+    }
+    else
+    {
+        m_stats.cpuTime = now - m_frameStart;
+        m_stats.presentTime = Time::Zero;
+    }
+
+    if (m_frameTimeLimit != Time::Zero)
+    {
+        if (now > m_deadline)
+        {
+            m_stats.missedDeadlines++;
+
+            // Too late to catch up: start a new schedule rather
+            // than rushing through the next frames
+            if (now - m_deadline >= m_frameTimeLimit)
+                m_deadline = now;
+        }
+        else
+        {
+            // Sleep as long as the OS can be trusted to wake us up in
+            // time, then spin until the deadline
+            Time remaining = m_deadline - now;
+            if (remaining > m_spinThreshold)
+                sleep(remaining - m_spinThreshold);
+
+            while (m_clock.getElapsedTime() < m_deadline)
+            {
+            }
+        }
+
+        // The next deadline is based on the previous one, so that
+        // waking up late doesn't shift all the following frames
+        m_deadline += m_frameTimeLimit;
+    }
+
+    Time frameEnd = m_clock.getElapsedTime();
+
+    m_stats.frameTime = frameEnd - m_frameStart;
+    m_stats.frameCount++;
+
+    m_frameStart = frameEnd;
+    m_presentStart = microseconds(-1);
+}
+
+
+////////////////////////////////////////////////////////////
+const FramePacer::Stats& FramePacer::getStats() const
+{
+    return m_stats;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFixedTimestep(Time timestep, unsigned int maxSteps)
+{
+    m_timestep = std::max(timestep, Time::Zero);
+    m_maxSteps = std::max(maxSteps, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+float FramePacer::getInterpolation() const
+{
+    if (m_timestep == Time::Zero)
+        return 0.f;
+
+    return m_accumulator.asSeconds() / m_timestep.asSeconds();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int FramePacer::accumulateSteps()
+{
+    Time now = m_clock.getElapsedTime();
+    m_accumulator += now - m_lastUpdate;
+    m_lastUpdate = now;
+
+    if (m_timestep == Time::Zero)
+        return 0;
+
+    Int64 step = m_timestep.asMicroseconds();
+    Int64 steps = m_accumulator.asMicroseconds() / step;
+
+    // Drop the time that we can't simulate without falling further behind
+    if (steps > m_maxSteps)
+    {
+        steps = m_maxSteps;
+        m_accumulator = microseconds(m_accumulator.asMicroseconds() % step);
+    }
+    else
+    {
+        m_accumulator -= m_timestep * steps;
+    }
+
+    return static_cast<unsigned int>(steps);
+}
+
+} // namespace sf
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/MappedFileImpl.hpp>
+#else
+    #include <SFML/System/Unix/MappedFileImpl.hpp>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MappedFileInputStream::MappedFileInputStream() :
+m_impl    (NULL),
+m_fallback(NULL),
+m_data    (NULL),
+m_size    (0),
+m_offset  (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileInputStream::~MappedFileInputStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileInputStream::open(const std::string& filename)
+{
+    close();
+
+    // Try to map the file in memory
+    m_impl = new priv::MappedFileImpl;
+    if (m_impl->open(filename))
+    {
+        m_data = m_impl->getData();
+        m_size = static_cast<Int64>(m_impl->getSize());
+        return true;
+    }
+
+    delete m_impl;
+    m_impl = NULL;
+
+    // Fall back to regular file I/O
+    m_fallback = new FileInputStream;
+    if (m_fallback->open(filename))
+        return true;
+
+    delete m_fallback;
+    m_fallback = NULL;
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileInputStream::setAccessPattern(AccessPattern pattern)
+{
+    if (m_impl)
+        m_impl->advise(pattern);
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileInputStream::isMapped() const
+{
+    return m_impl != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileInputStream::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::read(void* data, Int64 size)
+{
+    if (m_fallback)
+        return m_fallback->read(data, size);
+
+    if (!m_impl)
+        return -1;
+
+    Int64 endPosition = m_offset + size;
+    Int64 count = endPosition <= m_size ? size : m_size - m_offset;
+
+    if (count > 0)
+    {
+        std::memcpy(data, m_data + m_offset, static_cast<std::size_t>(count));
+        m_offset += count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::seek(Int64 position)
+{
+    if (m_fallback)
+        return m_fallback->seek(position);
+
+    if (!m_impl || (position < 0))
+        return -1;
+
+    m_offset = position < m_size ? position : m_size;
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::tell()
+{
+    if (m_fallback)
+        return m_fallback->tell();
+
+    if (!m_impl)
+        return -1;
+
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::getSize()
+{
+    if (m_fallback)
+        return m_fallback->getSize();
+
+    if (!m_impl)
+        return -1;
+
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileInputStream::close()
+{
+    delete m_impl;
+    delete m_fallback;
+
+    m_impl = NULL;
+    m_fallback = NULL;
+    m_data = NULL;
+    m_size = 0;
+    m_offset = 0;
+}
+
+} // namespace sf
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/SharedMutex.hpp>
+#include <SFML/System/ScopedLock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SharedMutex::SharedMutex() :
+m_readerCount   (0),
+m_waitingWriters(0),
+m_writing       (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::lock()
+{
+    ScopedLock<FastMutex> lock(m_mutex);
+
+    m_waitingWriters++;
+    while (m_writing || (m_readerCount > 0))
+        m_writers.wait(m_mutex);
+    m_waitingWriters--;
+
+    m_writing = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::unlock()
+{
+    ScopedLock<FastMutex> lock(m_mutex);
+
+    m_writing = false;
+
+    // Give the lock to the next writer if any, to all the readers otherwise
+    if (m_waitingWriters > 0)
+        m_writers.notifyOne();
+    else
+        m_readers.notifyAll();
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::lockShared()
+{
+    ScopedLock<FastMutex> lock(m_mutex);
+
+    // Don't overtake the waiting writers
+    while (m_writing || (m_waitingWriters > 0))
+        m_readers.wait(m_mutex);
+
+    m_readerCount++;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::unlockShared()
+{
+    ScopedLock<FastMutex> lock(m_mutex);
+
+    m_readerCount--;
+
+    if ((m_readerCount == 0) && (m_waitingWriters > 0))
+        m_writers.notifyOne();
+}
+
+} // namespace sf
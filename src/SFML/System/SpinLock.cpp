@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/SpinLock.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <sched.h>
+#endif
+
+
+namespace
+{
+    // Number of unsuccessful polls before giving the CPU away
+    const unsigned int spinCount = 64;
+
+    // Atomically set the lock flag, and return its previous value
+    long exchange(volatile long& flag, long value)
+    {
+    #if defined(_MSC_VER)
+        return InterlockedExchange(&flag, value);
+    #else
+        return __atomic_exchange_n(&flag, value, __ATOMIC_ACQUIRE);
+    #endif
+    }
+
+    // Read the lock flag, without ordering the surrounding accesses
+    long load(volatile long& flag)
+    {
+    #if defined(_MSC_VER)
+        return flag;
+    #else
+        return __atomic_load_n(&flag, __ATOMIC_RELAXED);
+    #endif
+    }
+
+    // Clear the lock flag, publishing the writes of the critical section
+    void release(volatile long& flag)
+    {
+    #if defined(_MSC_VER)
+        InterlockedExchange(&flag, 0);
+    #else
+        __atomic_store_n(&flag, 0, __ATOMIC_RELEASE);
+    #endif
+    }
+
+    // Let another thread run on this CPU
+    void yield()
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        SwitchToThread();
+    #else
+        sched_yield();
+    #endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpinLock::SpinLock() :
+m_locked(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SpinLock::lock()
+{
+    unsigned int spins = 0;
+
+    while (exchange(m_locked, 1) != 0)
+    {
+        // Only read the flag while it's held, so that waiting threads
+        // don't steal the cache line from the owner with their writes
+        while (load(m_locked) != 0)
+        {
+            if (++spins % spinCount == 0)
+                yield();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpinLock::unlock()
+{
+    release(m_locked);
+}
+
+} // namespace sf
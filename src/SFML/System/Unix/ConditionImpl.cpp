@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/ConditionImpl.hpp>
+#include <SFML/System/Unix/MutexImpl.hpp>
+#include <errno.h>
+#include <time.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionImpl::ConditionImpl()
+{
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS) || (defined(SFML_SYSTEM_ANDROID) && (__ANDROID_API__ < 21))
+
+    // Timed waits use a relative timeout, see wait()
+    pthread_cond_init(&m_condition, NULL);
+
+#else
+
+    // Measure the timeouts on the monotonic clock, so that they are not
+    // affected by changes of the system time
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_condition, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionImpl::~ConditionImpl()
+{
+    pthread_cond_destroy(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    if (timeout < Time::Zero)
+        return pthread_cond_wait(&m_condition, &mutex.m_mutex) == 0;
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    // Mac OS X has no clock selection, but accepts a relative timeout
+    Int64 usecs = timeout.asMicroseconds();
+
+    timespec duration;
+    duration.tv_sec = static_cast<time_t>(usecs / 1000000);
+    duration.tv_nsec = static_cast<long>(usecs % 1000000) * 1000;
+
+    return pthread_cond_timedwait_relative_np(&m_condition, &mutex.m_mutex, &duration) != ETIMEDOUT;
+
+#else
+
+    // pthread expects an absolute time on the clock of the condition
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    Int64 nsecs = now.tv_nsec + timeout.asMicroseconds() * 1000;
+
+    timespec deadline;
+    deadline.tv_sec = now.tv_sec + static_cast<time_t>(nsecs / 1000000000);
+    deadline.tv_nsec = static_cast<long>(nsecs % 1000000000);
+
+    #if defined(SFML_SYSTEM_ANDROID) && (__ANDROID_API__ < 21)
+        // Old Android versions lack pthread_condattr_setclock
+        return pthread_cond_timedwait_monotonic_np(&m_condition, &mutex.m_mutex, &deadline) != ETIMEDOUT;
+    #else
+        return pthread_cond_timedwait(&m_condition, &mutex.m_mutex, &deadline) != ETIMEDOUT;
+    #endif
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionImpl::notifyOne()
+{
+    pthread_cond_signal(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionImpl::notifyAll()
+{
+    pthread_cond_broadcast(&m_condition);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/MappedFileImpl.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+MappedFileImpl::MappedFileImpl() :
+m_data(NULL),
+m_size(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileImpl::~MappedFileImpl()
+{
+    if (m_data)
+        munmap(const_cast<char*>(m_data), static_cast<std::size_t>(m_size));
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileImpl::open(const std::string& filename)
+{
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file == -1)
+        return false;
+
+    // Only non-empty regular files that fit in the address space can be mapped
+    struct stat status;
+    if ((fstat(file, &status) == -1) || !S_ISREG(status.st_mode) || (status.st_size <= 0) ||
+        (static_cast<Uint64>(status.st_size) > std::numeric_limits<std::size_t>::max()))
+    {
+        ::close(file);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping stays valid after the file descriptor is closed
+    ::close(file);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    m_size = size;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* MappedFileImpl::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 MappedFileImpl::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileImpl::advise(MappedFileInputStream::AccessPattern pattern)
+{
+    if (!m_data)
+        return;
+
+    int advice = MADV_NORMAL;
+    switch (pattern)
+    {
+        case MappedFileInputStream::Normal:     advice = MADV_NORMAL;     break;
+        case MappedFileInputStream::Sequential: advice = MADV_SEQUENTIAL; break;
+        case MappedFileInputStream::Random:     advice = MADV_RANDOM;     break;
+        case MappedFileInputStream::WillNeed:   advice = MADV_WILLNEED;   break;
+    }
+
+    // This is only a hint, failures can be ignored
+    madvise(const_cast<char*>(m_data), static_cast<std::size_t>(m_size), advice);
+}
+
+} // namespace priv
+
+} // namespace sf
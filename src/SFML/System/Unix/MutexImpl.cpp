@@ -33,14 +33,24 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-MutexImpl::MutexImpl()
+MutexImpl::MutexImpl(bool recursive)
 {
-    // Make it recursive to follow the expected behavior
-    pthread_mutexattr_t attributes;
-    pthread_mutexattr_init(&attributes);
-    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    if (recursive)
+    {
+        // Make it recursive to follow the expected behavior
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
 
-    pthread_mutex_init(&m_mutex, &attributes);
+        pthread_mutex_init(&m_mutex, &attributes);
+
+        pthread_mutexattr_destroy(&attributes);
+    }
+    else
+    {
+        // The default mutex type skips the owner bookkeeping
+        pthread_mutex_init(&m_mutex, NULL);
+    }
 }
 
 
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/ConditionImpl.hpp>
+#include <SFML/System/Win32/MutexImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionImpl::ConditionImpl() :
+m_waiting   (0),
+m_releases  (0),
+m_generation(0)
+{
+    InitializeCriticalSection(&m_lock);
+    m_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionImpl::~ConditionImpl()
+{
+    CloseHandle(m_event);
+    DeleteCriticalSection(&m_lock);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    // Register as a waiter before releasing the mutex, so that a
+    // notification sent right after can't be missed
+    EnterCriticalSection(&m_lock);
+    ++m_waiting;
+    unsigned int generation = m_generation;
+    LeaveCriticalSection(&m_lock);
+
+    LeaveCriticalSection(&mutex.m_mutex);
+
+    DWORD delay = (timeout < Time::Zero) ? INFINITE : static_cast<DWORD>((timeout.asMicroseconds() + 999) / 1000);
+    DWORD start = GetTickCount();
+    bool signaled = false;
+    for (;;)
+    {
+        DWORD remaining = INFINITE;
+        if (delay != INFINITE)
+        {
+            DWORD elapsed = GetTickCount() - start;
+            remaining = (elapsed < delay) ? delay - elapsed : 0;
+        }
+
+        bool timedOut = (WaitForSingleObject(m_event, remaining) != WAIT_OBJECT_0);
+
+        EnterCriticalSection(&m_lock);
+
+        // Only the threads which were waiting when a notification was
+        // sent may take it; a thread which times out still takes it if
+        // it can, so that it is not lost
+        if ((m_releases > 0) && (m_generation != generation))
+        {
+            signaled = true;
+            if (--m_releases == 0)
+                ResetEvent(m_event);
+        }
+
+        if (signaled || timedOut)
+        {
+            --m_waiting;
+            LeaveCriticalSection(&m_lock);
+            break;
+        }
+
+        LeaveCriticalSection(&m_lock);
+
+        // The event is set for older waiters, let them take it
+        Sleep(0);
+    }
+
+    EnterCriticalSection(&mutex.m_mutex);
+
+    return signaled;
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionImpl::notifyOne()
+{
+    EnterCriticalSection(&m_lock);
+    if (m_waiting > m_releases)
+    {
+        ++m_releases;
+        ++m_generation;
+        SetEvent(m_event);
+    }
+    LeaveCriticalSection(&m_lock);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionImpl::notifyAll()
+{
+    EnterCriticalSection(&m_lock);
+    if (m_waiting > m_releases)
+    {
+        m_releases = m_waiting;
+        ++m_generation;
+        SetEvent(m_event);
+    }
+    LeaveCriticalSection(&m_lock);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_MAPPEDFILEIMPLWIN32_HPP
+#define SFML_MAPPEDFILEIMPLWIN32_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <windows.h>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Win32 implementation of the memory mapping of a file
+///
+////////////////////////////////////////////////////////////
+class MappedFileImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFileImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor, unmaps the file
+    ///
+    ////////////////////////////////////////////////////////////
+    ~MappedFileImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a file in memory
+    ///
+    /// \param filename Name of the file to map
+    ///
+    /// \return True on success, false if the file can't be mapped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the mapped file contents
+    ///
+    /// \return Pointer to the file contents
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the mapped file
+    ///
+    /// \return Size of the file, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the system how the mapped file is going to be accessed
+    ///
+    /// \param pattern Expected access pattern
+    ///
+    ////////////////////////////////////////////////////////////
+    void advise(MappedFileInputStream::AccessPattern pattern);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    HANDLE      m_file;    ///< Handle of the open file
+    HANDLE      m_mapping; ///< Handle of the file mapping object
+    const char* m_data;    ///< Address of the mapped view
+    Uint64      m_size;    ///< Size of the file, in bytes
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_MAPPEDFILEIMPLWIN32_HPP
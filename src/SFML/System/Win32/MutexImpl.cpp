@@ -33,9 +33,14 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-MutexImpl::MutexImpl()
+MutexImpl::MutexImpl(bool recursive)
 {
-    InitializeCriticalSection(&m_mutex);
+    // Critical sections are always recursive; for the mutexes meant
+    // for short critical sections, spin a little before sleeping
+    if (recursive)
+        InitializeCriticalSection(&m_mutex);
+    else
+        InitializeCriticalSectionAndSpinCount(&m_mutex, 4000);
 }
 
 
@@ -46,8 +46,10 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// \param recursive Can the mutex be locked multiple times by the same thread?
+    ///
     ////////////////////////////////////////////////////////////
-    MutexImpl();
+    explicit MutexImpl(bool recursive = true);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -69,6 +71,8 @@ public:
 
 private:
 
+    friend class ConditionImpl;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
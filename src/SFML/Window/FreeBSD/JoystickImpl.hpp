@@ -67,6 +67,19 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that signal joystick changes
+    ///
+    /// Joysticks are scanned on FreeBSD, so no change is
+    /// signaled through file descriptors.
+    ///
+    /// \param descriptors Array to append the descriptors to
+    ///
+    /// \return Always false, joysticks must be polled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getDescriptors(std::vector<int>& descriptors);
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
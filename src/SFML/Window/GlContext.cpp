@@ -27,8 +27,11 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/System/ThreadLocalPtr.hpp>
-#include <SFML/System/Mutex.hpp>
+#include <SFML/System/FastMutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/ScopedLock.hpp>
+#include <SFML/System/SpinLock.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/OpenGL.hpp>
 #include <set>
@@ -130,10 +133,14 @@ namespace
     // The hidden, inactive context that will be shared with all other contexts
     ContextType* sharedContext = NULL;
 
+    // Source of the unique context identifiers
+    sf::Uint64 nextContextId = 1;
+    sf::SpinLock idLock;
+
     // Internal contexts
     sf::ThreadLocalPtr<sf::priv::GlContext> internalContext(NULL);
     std::set<sf::priv::GlContext*> internalContexts;
-    sf::Mutex internalContextsMutex;
+    sf::FastMutex internalContextsMutex;
 
     // Check if the internal context of the current thread is valid
     bool hasInternalContext()
@@ -143,7 +150,7 @@ namespace
             return false;
 
         // ... or non-null but deleted from the list of internal contexts
-        sf::Lock lock(internalContextsMutex);
+        sf::ScopedLock<sf::FastMutex> lock(internalContextsMutex);
         return internalContexts.find(internalContext) != internalContexts.end();
     }
 
@@ -153,7 +160,7 @@ namespace
         if (!hasInternalContext())
         {
             internalContext = sf::priv::GlContext::create();
-            sf::Lock lock(internalContextsMutex);
+            sf::ScopedLock<sf::FastMutex> lock(internalContextsMutex);
             internalContexts.insert(internalContext);
         }
 
@@ -192,7 +199,7 @@ void GlContext::globalCleanup()
     sharedContext = NULL;
 
     // Destroy the internal contexts
-    Lock internalContextsLock(internalContextsMutex);
+    ScopedLock<FastMutex> internalContextsLock(internalContextsMutex);
     for (std::set<GlContext*>::iterator it = internalContexts.begin(); it != internalContexts.end(); ++it)
         delete *it;
     internalContexts.clear();
@@ -272,6 +279,14 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getActiveContextId()
+{
+    GlContext* context = currentContext;
+    return context ? context->m_id : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -335,7 +350,8 @@ bool GlContext::setActive(bool active)
 ////////////////////////////////////////////////////////////
 GlContext::GlContext()
 {
-    // Nothing to do
+    ScopedLock<SpinLock> lock(idLock);
+    m_id = nextContextId++;
 }
 
 
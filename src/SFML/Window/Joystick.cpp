@@ -80,6 +80,20 @@ void Joystick::update()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Joystick::setInputThreadEnabled(bool enabled)
+{
+    return priv::JoystickManager::getInstance().setSamplingEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+Time Joystick::getTimestamp()
+{
+    return microseconds(priv::JoystickManager::getInstance().getTimestamp());
+}
+
+
 ////////////////////////////////////////////////////////////
 Joystick::Identification::Identification() :
 name     ("No Joystick"),
@@ -26,12 +26,77 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickManager.hpp>
+#if defined(SFML_SYSTEM_LINUX)
+    #include <SFML/Window/LockFreeQueue.hpp>
+    #include <SFML/System/Lock.hpp>
+    #include <SFML/System/Mutex.hpp>
+    #include <SFML/System/Thread.hpp>
+    #include <algorithm>
+#endif
+
+
+namespace
+{
+    // Maximum number of samples waiting in the queue, and kept in the history
+    const std::size_t maxSamples = 1024;
+}
 
 
 namespace sf
 {
 namespace priv
 {
+#if defined(SFML_SYSTEM_LINUX)
+
+////////////////////////////////////////////////////////////
+struct JoystickManager::Sampler
+{
+    Sampler(JoystickManager& manager) :
+    thread (&JoystickManager::sample, &manager),
+    queue  (maxSamples),
+    running(true)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool push(unsigned int index, const JoystickImpl& joystick, Int64 timestamp)
+    {
+        Sample sample;
+        sample.joystick = index;
+        sample.timestamp = timestamp;
+        sample.state = states[index];
+        sample.capabilities = capabilities[index];
+
+        // The identification is published before the first sample of a
+        // connection, which tells update() to fetch it; it is kept out of
+        // the samples so that pushing them never allocates
+        if (sample.state.connected && !announced[index])
+        {
+            Lock lock(mutex);
+            identifications[index] = joystick.getIdentification();
+        }
+
+        if (!queue.push(sample))
+            return false;
+
+        announced[index] = sample.state.connected;
+        return true;
+    }
+
+    Thread                   thread;                           ///< Thread reading the joysticks
+    LockFreeQueue<Sample>    queue;                            ///< Samples waiting to be processed by update()
+    JoystickState            states[Joystick::Count];          ///< Latest states read by the thread
+    JoystickCaps             capabilities[Joystick::Count];    ///< Capabilities of the connected joysticks
+    bool                     pending[Joystick::Count];         ///< Latest states which didn't fit in the queue yet
+    bool                     announced[Joystick::Count];       ///< Was the connection of the joysticks pushed?
+    Mutex                    mutex;                            ///< Mutex protecting the members below
+    Joystick::Identification identifications[Joystick::Count]; ///< Identification of the joysticks, written on connection
+    bool                     running;                          ///< Should the thread keep running?
+};
+
+#endif
+
+
 ////////////////////////////////////////////////////////////
 JoystickManager& JoystickManager::getInstance()
 {
@@ -64,6 +129,13 @@ const Joystick::Identification& JoystickManager::getIdentification(unsigned int
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
 {
+    // The sampling thread reads the joysticks if it runs
+    if (m_sampler)
+    {
+        processSamples();
+        return;
+    }
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         Item& item = m_joysticks[i];
@@ -100,7 +172,95 @@ void JoystickManager::update()
 
 
 ////////////////////////////////////////////////////////////
-JoystickManager::JoystickManager()
+bool JoystickManager::setSamplingEnabled(bool enabled)
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    if (enabled == (m_sampler != NULL))
+        return true;
+
+    if (enabled)
+    {
+        if (!JoystickImpl::setSamplingThread(true))
+            return false;
+
+        // The thread takes the joysticks over in their current state
+        m_sampler = new Sampler(*this);
+        for (int i = 0; i < Joystick::Count; ++i)
+        {
+            m_sampler->states[i] = m_joysticks[i].state;
+            m_sampler->capabilities[i] = m_joysticks[i].capabilities;
+            m_sampler->pending[i] = false;
+            m_sampler->announced[i] = m_joysticks[i].state.connected;
+        }
+
+        m_sampler->thread.launch();
+    }
+    else
+    {
+        {
+            Lock lock(m_sampler->mutex);
+            m_sampler->running = false;
+        }
+
+        m_sampler->thread.wait();
+
+        // Apply the last samples before update() reads the joysticks again;
+        // it catches up with the states that didn't fit in the queue
+        processSamples();
+
+        delete m_sampler;
+        m_sampler = NULL;
+
+        JoystickImpl::setSamplingThread(false);
+
+        // The windows go back to comparing the states
+        m_firstSample += m_samples.size();
+        m_samples.clear();
+    }
+
+    return true;
+
+#else
+
+    return !enabled;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickManager::isSamplingEnabled() const
+{
+    return m_sampler != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 JoystickManager::getTimestamp() const
+{
+    return m_clock.getElapsedTime().asMicroseconds();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::deque<JoystickManager::Sample>& JoystickManager::getSamples() const
+{
+    return m_samples;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 JoystickManager::getFirstSample() const
+{
+    return m_firstSample;
+}
+
+
+////////////////////////////////////////////////////////////
+JoystickManager::JoystickManager() :
+m_sampler    (NULL),
+m_firstSample(0)
 {
     JoystickImpl::initialize();
 }
@@ -109,6 +269,8 @@ JoystickManager::JoystickManager()
 ////////////////////////////////////////////////////////////
 JoystickManager::~JoystickManager()
 {
+    setSamplingEnabled(false);
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         if (m_joysticks[i].state.connected)
@@ -118,6 +280,128 @@ JoystickManager::~JoystickManager()
     JoystickImpl::cleanup();
 }
 
+
+////////////////////////////////////////////////////////////
+void JoystickManager::processSamples()
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Clear the notifications first, so that a sample pushed
+    // after the queue is emptied notifies the windows again
+    JoystickImpl::clearNotifications();
+
+    Sample sample;
+    while (m_sampler->queue.pop(sample))
+    {
+        Item& item = m_joysticks[sample.joystick];
+
+        if (sample.state.connected != item.state.connected)
+        {
+            if (sample.state.connected)
+            {
+                Lock lock(m_sampler->mutex);
+                item.identification = m_sampler->identifications[sample.joystick];
+            }
+            else
+            {
+                item.identification = Joystick::Identification();
+            }
+        }
+
+        item.state        = sample.state;
+        item.capabilities = sample.capabilities;
+        m_samples.push_back(sample);
+    }
+
+    // Windows which didn't process the oldest samples will catch up with the states
+    while (m_samples.size() > maxSamples)
+    {
+        m_samples.pop_front();
+        m_firstSample++;
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickManager::sample()
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    Sampler& sampler = *m_sampler;
+
+    for (;;)
+    {
+        {
+            Lock lock(sampler.mutex);
+            if (!sampler.running)
+                break;
+        }
+
+        // Wake up regularly to check whether we must stop, and
+        // soon when some states are waiting for room in the queue
+        bool pending = (std::find(sampler.pending, sampler.pending + Joystick::Count, true) != sampler.pending + Joystick::Count);
+        bool connections = JoystickImpl::waitForEvents(milliseconds(pending ? 1 : 50));
+
+        bool pushed = false;
+        for (int i = 0; i < Joystick::Count; ++i)
+        {
+            JoystickImpl& joystick = m_joysticks[i].joystick;
+            JoystickState& state = sampler.states[i];
+
+            // Don't read any further while the queue is full, the events
+            // wait in the device until there's room
+            if (sampler.pending[i])
+            {
+                if (!sampler.push(i, joystick, getTimestamp()))
+                    continue;
+
+                sampler.pending[i] = false;
+                pushed = true;
+            }
+
+            if (state.connected)
+            {
+                // Push one sample per event, so that no change is lost
+                while (joystick.readEvent(state))
+                {
+                    if (!sampler.push(i, joystick, getTimestamp()))
+                    {
+                        sampler.pending[i] = true;
+                        break;
+                    }
+
+                    pushed = true;
+                }
+
+                if (!sampler.pending[i] && !state.connected)
+                {
+                    joystick.close();
+                    state = JoystickState();
+                    sampler.capabilities[i] = JoystickCaps();
+
+                    sampler.pending[i] = !sampler.push(i, joystick, getTimestamp());
+                    pushed = pushed || !sampler.pending[i];
+                }
+            }
+            else if (connections && JoystickImpl::isConnected(i) && joystick.open(i))
+            {
+                state = joystick.update();
+                sampler.capabilities[i] = joystick.getCapabilities();
+
+                sampler.pending[i] = !sampler.push(i, joystick, getTimestamp());
+                pushed = pushed || !sampler.pending[i];
+            }
+        }
+
+        if (pushed)
+            JoystickImpl::notify();
+    }
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
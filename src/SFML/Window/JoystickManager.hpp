@@ -30,7 +30,9 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <deque>
 
 
 namespace sf
@@ -45,6 +47,22 @@ class JoystickManager : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a joystick read by the sampling thread
+    ///
+    /// Samples are copied through a lock-free queue for every
+    /// event, so they only hold plain data; the identification
+    /// of a joystick is passed separately when it gets connected.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Sample
+    {
+        unsigned int  joystick;     ///< Index of the joystick
+        Int64         timestamp;    ///< Time of the sample, in microseconds
+        JoystickState state;        ///< State of the joystick
+        JoystickCaps  capabilities; ///< Capabilities of the joystick
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the global unique instance of the manager
     ///
@@ -89,6 +107,53 @@ public:
     ////////////////////////////////////////////////////////////
     void update();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop the thread sampling the joysticks
+    ///
+    /// \param enabled True to start the thread, false to stop it
+    ///
+    /// \return True on success, false if the thread is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setSamplingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sampling thread is running
+    ///
+    /// \return True if the joysticks are read by the sampling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSamplingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the clock timestamping the joysticks
+    ///
+    /// \return Current time, in microseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    Int64 getTimestamp() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the recent samples of the sampling thread
+    ///
+    /// Each window keeps track of the samples it has processed
+    /// with their sequence number: the first sample of the history
+    /// has the sequence number getFirstSample(), and the history
+    /// is trimmed when it grows too large.
+    ///
+    /// \return History of the samples processed by update()
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::deque<Sample>& getSamples() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sequence number of the first sample of the history
+    ///
+    /// \return Sequence number of the first sample returned by getSamples()
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getFirstSample() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -115,10 +180,28 @@ private:
         Joystick::Identification identification; ///< The joystick identification
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the samples pushed by the sampling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void processSamples();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the sampling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void sample();
+
+    struct Sampler;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Item m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    Item               m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    Clock              m_clock;                      ///< Clock timestamping the joystick events
+    Sampler*           m_sampler;                    ///< Sampling thread, if running
+    std::deque<Sample> m_samples;                    ///< History of the samples, for the windows
+    Uint64             m_firstSample;                ///< Sequence number of the first sample of the history
 };
 
 } // namespace priv
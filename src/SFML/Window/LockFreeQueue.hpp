@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_LOCKFREEQUEUE_HPP
+#define SFML_LOCKFREEQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded queue for passing items from one thread to another
+///
+/// A single thread may push items and a single other thread
+/// may pop them; neither of them ever waits for the other.
+/// The indices are synchronized with the GCC atomic builtins,
+/// which clang supports as well.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class LockFreeQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// \param capacity Maximum number of items in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit LockFreeQueue(std::size_t capacity) :
+    m_items(capacity + 1),
+    m_head (0),
+    m_tail (0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push an item at the back of the queue
+    ///
+    /// This function must only be called by the producer thread.
+    ///
+    /// \param item Item to push
+    ///
+    /// \return True if the item was pushed, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& item)
+    {
+        std::size_t tail = m_tail;
+        std::size_t next = (tail + 1) % m_items.size();
+
+        if (next == __atomic_load_n(&m_head, __ATOMIC_ACQUIRE))
+            return false;
+
+        // The slot is not visible to the consumer until the tail is published
+        m_items[tail] = item;
+        __atomic_store_n(&m_tail, next, __ATOMIC_RELEASE);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop the item at the front of the queue
+    ///
+    /// This function must only be called by the consumer thread.
+    ///
+    /// \param item Variable to fill with the popped item
+    ///
+    /// \return True if an item was popped, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& item)
+    {
+        std::size_t head = m_head;
+
+        if (head == __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE))
+            return false;
+
+        // The producer doesn't reuse the slot until the head is published
+        item = m_items[head];
+        __atomic_store_n(&m_head, (head + 1) % m_items.size(), __ATOMIC_RELEASE);
+
+        return true;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T> m_items;       ///< Ring buffer of items, with one slot always free
+    std::size_t    m_head;        ///< Index of the front item, written by the consumer
+    char           m_padding[64]; ///< Keeps the indices on separate cache lines
+    std::size_t    m_tail;        ///< Index past the back item, written by the producer
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_LOCKFREEQUEUE_HPP
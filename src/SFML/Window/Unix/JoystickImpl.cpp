@@ -26,12 +26,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <linux/joystick.h>
 #include <libudev.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <errno.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -51,6 +54,17 @@ namespace
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    // File descriptors of the opened joysticks
+    std::vector<int> joystickFiles;
+
+    // Pipe signaled by the sampling thread when it has new samples
+    int notificationPipe[2] = {-1, -1};
+
+    // Without udev monitor, the sampling thread scans for new joysticks
+    // periodically, since a scan is expensive
+    const sf::Time scanPeriod = sf::milliseconds(100);
+    sf::Clock scanClock;
+
     bool isJoystick(udev_device* udevDevice)
     {
         // If anything goes wrong, we go safe and return true
@@ -262,6 +276,19 @@ namespace
                FD_ISSET(monitorFd, &descriptorSet);
     }
 
+    void processMonitorEvent()
+    {
+        // Check if new joysticks were added/removed since last update
+        udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+
+        // If we can get the specific device, we check that,
+        // otherwise just do a full scan if udevDevice == NULL
+        updatePluggedList(udevDevice);
+
+        if (udevDevice)
+            udev_device_unref(udevDevice);
+    }
+
     // Get a property value from a udev device
     const char* getUdevAttribute(udev_device* udevDevice, const std::string& attributeName)
     {
@@ -516,15 +543,7 @@ bool JoystickImpl::isConnected(unsigned int index)
     }
     else if (hasMonitorEvent())
     {
-        // Check if new joysticks were added/removed since last update
-        udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
-
-        // If we can get the specific device, we check that,
-        // otherwise just do a full scan if udevDevice == NULL
-        updatePluggedList(udevDevice);
-
-        if (udevDevice)
-            udev_device_unref(udevDevice);
+        processMonitorEvent();
     }
 
     if (index >= joystickList.size())
@@ -534,6 +553,132 @@ bool JoystickImpl::isConnected(unsigned int index)
     return joystickList[index].plugged;
 }
 
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::getDescriptors(std::vector<int>& descriptors)
+{
+    // The devices belong to the sampling thread if it runs
+    if (notificationPipe[0] >= 0)
+    {
+        descriptors.push_back(notificationPipe[0]);
+        return true;
+    }
+
+    descriptors.insert(descriptors.end(), joystickFiles.begin(), joystickFiles.end());
+
+    // Without the udev monitor, connections can only be detected by scanning the devices
+    if (!udevMonitor)
+        return false;
+
+    descriptors.push_back(udev_monitor_get_fd(udevMonitor));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::processConnectionEvents()
+{
+    // The monitor belongs to the sampling thread if it runs
+    if ((notificationPipe[0] >= 0) || !udevMonitor)
+        return;
+
+    while (hasMonitorEvent())
+        processMonitorEvent();
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::setSamplingThread(bool enabled)
+{
+    if (enabled)
+    {
+        if (pipe(notificationPipe) < 0)
+        {
+            err() << "Failed to create the joystick notification pipe: " << errno << std::endl;
+            return false;
+        }
+
+        // Neither notifying nor clearing the notifications may block
+        fcntl(notificationPipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(notificationPipe[1], F_SETFL, O_NONBLOCK);
+    }
+    else if (notificationPipe[0] >= 0)
+    {
+        ::close(notificationPipe[0]);
+        ::close(notificationPipe[1]);
+        notificationPipe[0] = -1;
+        notificationPipe[1] = -1;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::waitForEvents(Time timeout)
+{
+    std::vector<pollfd> descriptors(joystickFiles.size());
+    for (std::size_t i = 0; i < joystickFiles.size(); ++i)
+    {
+        descriptors[i].fd = joystickFiles[i];
+        descriptors[i].events = POLLIN;
+        descriptors[i].revents = 0;
+    }
+
+    if (udevMonitor)
+    {
+        pollfd monitor;
+        monitor.fd = udev_monitor_get_fd(udevMonitor);
+        monitor.events = POLLIN;
+        monitor.revents = 0;
+        descriptors.push_back(monitor);
+    }
+
+    int delay = static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+    int result = poll(descriptors.empty() ? NULL : &descriptors[0], descriptors.size(), delay);
+
+    if (!udevMonitor)
+    {
+        if (scanClock.getElapsedTime() < scanPeriod)
+            return false;
+
+        scanClock.restart();
+        return true;
+    }
+
+    // Consume the monitor event here, it could stay pending forever
+    // if no joystick slot is free to check it
+    if ((result > 0) && (descriptors.back().revents & POLLIN))
+    {
+        processMonitorEvent();
+        return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::notify()
+{
+    // The pipe is non-blocking: if it is full, the windows are notified anyway
+    char signal = 0;
+    ssize_t result = write(notificationPipe[1], &signal, 1);
+    static_cast<void>(result);
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::clearNotifications()
+{
+    char buffer[64];
+    while (read(notificationPipe[0], buffer, sizeof(buffer)) > 0)
+    {
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
@@ -563,6 +708,8 @@ bool JoystickImpl::open(unsigned int index)
             // Reset the joystick state
             m_state = JoystickState();
 
+            joystickFiles.push_back(m_file);
+
             return true;
         }
         else
@@ -578,6 +725,10 @@ bool JoystickImpl::open(unsigned int index)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::close()
 {
+    std::vector<int>::iterator it = std::find(joystickFiles.begin(), joystickFiles.end(), m_file);
+    if (it != joystickFiles.end())
+        joystickFiles.erase(it);
+
     ::close(m_file);
     m_file = -1;
 }
@@ -632,17 +783,30 @@ Joystick::Identification JoystickImpl::getIdentification() const
 
 ////////////////////////////////////////////////////////////
 JoystickState JoystickImpl::JoystickImpl::update()
+{
+    // Pop all the events from the joystick file
+    JoystickState state;
+    while (readEvent(state))
+    {
+    }
+
+    return state;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::readEvent(JoystickState& state)
 {
     if (m_file < 0)
     {
         m_state = JoystickState();
-        return m_state;
+        state = m_state;
+        return false;
     }
 
-    // pop events from the joystick file
     js_event joyState;
     int result = read(m_file, &joyState, sizeof(joyState));
-    while (result > 0)
+    if (result > 0)
     {
         switch (joyState.type & ~JS_EVENT_INIT)
         {
@@ -676,7 +840,9 @@ JoystickState JoystickImpl::JoystickImpl::update()
             }
         }
 
-        result = read(m_file, &joyState, sizeof(joyState));
+        m_state.connected = true;
+        state = m_state;
+        return true;
     }
 
     // Check the connection state of the joystick
@@ -688,7 +854,8 @@ JoystickState JoystickImpl::JoystickImpl::update()
     // If result is negative, check errno and disconnect if it is not EAGAIN
     m_state.connected = (!result || (errno == EAGAIN));
 
-    return m_state;
+    state = m_state;
+    return false;
 }
 
 } // namespace priv
@@ -29,7 +29,9 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
+#include <SFML/System/Time.hpp>
 #include <linux/input.h>
+#include <vector>
 
 
 namespace sf
@@ -66,6 +68,78 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that signal joystick changes
+    ///
+    /// The descriptors become readable when a joystick is
+    /// connected, disconnected, or changes its state. They
+    /// are meant to be waited on with poll().
+    ///
+    /// \param descriptors Array to append the descriptors to
+    ///
+    /// \return True if all the changes are signaled through the
+    ///         descriptors, false if joysticks must also be polled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getDescriptors(std::vector<int>& descriptors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the pending connection events
+    ///
+    /// The udev monitor descriptor returned by getDescriptors
+    /// stays readable until its events are received; they are
+    /// otherwise only received when a disconnected slot is
+    /// checked. Whoever polls the descriptors must call this
+    /// function afterwards, so that the next poll doesn't
+    /// return immediately.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void processConnectionEvents();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the joysticks are read by a sampling thread
+    ///
+    /// While the sampling thread runs, getDescriptors returns a
+    /// descriptor signaled by notify() instead of the descriptors
+    /// of the devices, which only the sampling thread reads.
+    ///
+    /// \param enabled True if the sampling thread is about to start,
+    ///                false if it has stopped
+    ///
+    /// \return True on success, false if the notifications can't be set up
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setSamplingThread(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the joysticks have new data
+    ///
+    /// This function is meant for the sampling thread.
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if joysticks may have been connected or disconnected
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool waitForEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up the windows waiting for joystick events
+    ///
+    /// This function is meant for the sampling thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void notify();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Acknowledge the notifications of the sampling thread
+    ///
+    /// This function must be called before processing the samples,
+    /// so that the samples pushed afterwards are notified again.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearNotifications();
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -106,6 +180,17 @@ public:
     ////////////////////////////////////////////////////////////
     JoystickState update();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the next pending event of the joystick
+    ///
+    /// \param state Filled with the state of the joystick after the event,
+    ///              or with its current state if there's no pending event
+    ///
+    /// \return True if an event was read, false if there was none
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readEvent(JoystickState& state);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@
 #include <unistd.h>
 #include <libgen.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -597,6 +598,43 @@ void WindowImplX11::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::waitForEvents(Time timeout)
+{
+    std::vector<int> descriptors(1, ConnectionNumber(m_display));
+
+    // Send the pending requests first, the server may be about to answer with events
+    XFlush(m_display);
+
+    // Poll regularly as before when the joysticks can't signal all their changes,
+    // or when Xlib already holds events (for other windows) that poll can't see
+    bool complete = JoystickImpl::getDescriptors(descriptors);
+    if (!complete || (XEventsQueued(m_display, QueuedAlready) > 0))
+    {
+        Time pollPeriod = milliseconds(10);
+        if ((timeout < Time::Zero) || (timeout > pollPeriod))
+            timeout = pollPeriod;
+    }
+
+    std::vector<pollfd> pollDescriptors(descriptors.size());
+    for (std::size_t i = 0; i < descriptors.size(); ++i)
+    {
+        pollDescriptors[i].fd = descriptors[i];
+        pollDescriptors[i].events = POLLIN;
+        pollDescriptors[i].revents = 0;
+    }
+
+    // Round the timeout up, so that we don't wake up just before it expires
+    int delay = (timeout < Time::Zero) ? -1 : static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+
+    poll(&pollDescriptors[0], pollDescriptors.size(), delay);
+
+    // Receive the joystick connection events, otherwise the udev monitor
+    // stays readable and the next poll returns immediately
+    JoystickImpl::processConnectionEvents();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplX11::getPosition() const
 {
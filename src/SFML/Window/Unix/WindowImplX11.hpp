@@ -178,6 +178,18 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    /// Blocks on the connection to the X server together with
+    /// the joystick descriptors, so that the thread doesn't
+    /// wake up as long as nothing happens.
+    ///
+    /// \param timeout Maximum time to wait, or a negative time to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
 private:
 
     struct WMHints
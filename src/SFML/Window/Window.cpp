@@ -28,7 +28,6 @@
 #include <SFML/Window/Window.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
 
 
@@ -42,10 +41,9 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Window::Window() :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl   (NULL),
+m_context(NULL),
+m_size   (0, 0)
 {
 
 }
@@ -53,10 +51,9 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl   (NULL),
+m_context(NULL),
+m_size   (0, 0)
 {
     create(mode, title, style, settings);
 }
@@ -64,10 +61,9 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl   (NULL),
+m_context(NULL),
+m_size   (0, 0)
 {
     create(handle, settings);
 }
@@ -209,6 +205,20 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::waitEvent(Event& event, Time timeout)
+{
+    if (m_impl && m_impl->popEvent(event, timeout))
+    {
+        return filterEvent(event);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -300,9 +310,9 @@ void Window::setKeyRepeatEnabled(bool enabled)
 void Window::setFramerateLimit(unsigned int limit)
 {
     if (limit > 0)
-        m_frameTimeLimit = seconds(1.f / limit);
+        m_pacer.setFrameTimeLimit(microseconds(1000000 / limit));
     else
-        m_frameTimeLimit = Time::Zero;
+        m_pacer.setFrameTimeLimit(Time::Zero);
 }
 
 
@@ -355,16 +365,23 @@ bool Window::hasFocus() const
 
 void Window::display()
 {
+    // Let the derived class finish its rendering
+    onDisplay();
+
     // Display the backbuffer on screen
+    m_pacer.beginPresent();
     if (setActive())
         m_context->display();
 
-    // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+    // Wait for the deadline of the frame if the framerate is limited
+    m_pacer.endFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+const FramePacer::Stats& Window::getFrameStats() const
+{
+    return m_pacer.getStats();
 }
 
 
@@ -389,6 +406,13 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {
@@ -421,7 +445,7 @@ void Window::initialize()
     m_size = m_impl->getSize();
 
     // Reset frame time
-    m_clock.restart();
+    m_pacer.restart();
 
     // Activate the window
     setActive();
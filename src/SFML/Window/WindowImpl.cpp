@@ -29,6 +29,7 @@
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/JoystickManager.hpp>
 #include <SFML/Window/SensorManager.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <algorithm>
 #include <cmath>
@@ -84,9 +85,13 @@ WindowImpl::WindowImpl() :
 m_joystickThreshold(0.1f)
 {
     // Get the initial joystick states
-    JoystickManager::getInstance().update();
+    JoystickManager& manager = JoystickManager::getInstance();
+    manager.update();
     for (unsigned int i = 0; i < Joystick::Count; ++i)
-        m_joystickStates[i] = JoystickManager::getInstance().getState(i);
+        m_joystickStates[i] = manager.getState(i);
+
+    // The samples received so far are already part of the states
+    m_nextJoystickSample = manager.getFirstSample() + manager.getSamples().size();
 
     // Get the initial sensor states
     for (unsigned int i = 0; i < Sensor::Count; ++i)
@@ -110,6 +115,20 @@ void WindowImpl::setJoystickThreshold(float threshold)
 
 ////////////////////////////////////////////////////////////
 bool WindowImpl::popEvent(Event& event, bool block)
+{
+    return popEvent(event, block, microseconds(-1));
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::popEvent(Event& event, Time timeout)
+{
+    return popEvent(event, true, std::max(timeout, Time::Zero));
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::popEvent(Event& event, bool block, Time timeout)
 {
     // If the event queue is empty, let's first check if new events are available from the OS
     if (m_events.empty())
@@ -122,12 +141,20 @@ bool WindowImpl::popEvent(Event& event, bool block)
         // In blocking mode, we must process events until one is triggered
         if (block)
         {
-            // Here we use a manual wait loop instead of the optimized
-            // wait-event provided by the OS, so that we don't skip joystick
-            // events (which require polling)
+            Clock clock;
             while (m_events.empty())
             {
-                sleep(milliseconds(10));
+                // Wait until something happens, without exceeding the timeout
+                Time remaining = timeout;
+                if (timeout >= Time::Zero)
+                {
+                    remaining = timeout - clock.getElapsedTime();
+                    if (remaining <= Time::Zero)
+                        break;
+                }
+
+                waitForEvents(remaining);
+
                 processJoystickEvents();
                 processSensorEvents();
                 processEvents();
@@ -148,6 +175,18 @@ bool WindowImpl::popEvent(Event& event, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::waitForEvents(Time timeout)
+{
+    // Joysticks and sensors have to be polled, don't sleep too long
+    Time pollPeriod = milliseconds(10);
+    if ((timeout < Time::Zero) || (timeout > pollPeriod))
+        timeout = pollPeriod;
+
+    sleep(timeout);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImpl::pushEvent(const Event& event)
 {
@@ -158,62 +197,92 @@ void WindowImpl::pushEvent(const Event& event)
 ////////////////////////////////////////////////////////////
 void WindowImpl::processJoystickEvents()
 {
+    JoystickManager& manager = JoystickManager::getInstance();
+
     // First update the global joystick states
-    JoystickManager::getInstance().update();
+    manager.update();
 
-    for (unsigned int i = 0; i < Joystick::Count; ++i)
+    if (manager.isSamplingEnabled())
     {
-        // Copy the previous state of the joystick and get the new one
-        JoystickState previousState = m_joystickStates[i];
-        m_joystickStates[i] = JoystickManager::getInstance().getState(i);
-        JoystickCaps caps = JoystickManager::getInstance().getCapabilities(i);
-
-        // Connection state
-        bool connected = m_joystickStates[i].connected;
-        if (previousState.connected ^ connected)
+        // Replay the samples of the input thread that we haven't seen yet,
+        // so that every change gets its own event and timestamp
+        const std::deque<JoystickManager::Sample>& samples = manager.getSamples();
+        Uint64 first = manager.getFirstSample();
+        Uint64 end = first + samples.size();
+
+        for (Uint64 i = std::max(m_nextJoystickSample, first); i < end; ++i)
         {
-            Event event;
-            event.type = connected ? Event::JoystickConnected : Event::JoystickDisconnected;
-            event.joystickButton.joystickId = i;
-            pushEvent(event);
+            const JoystickManager::Sample& sample = samples[static_cast<std::size_t>(i - first)];
+            processJoystickState(sample.joystick, sample.state, sample.capabilities, sample.timestamp);
         }
 
-        if (connected)
+        m_nextJoystickSample = end;
+    }
+    else
+    {
+        Int64 timestamp = manager.getTimestamp();
+
+        for (unsigned int i = 0; i < Joystick::Count; ++i)
+            processJoystickState(i, manager.getState(i), manager.getCapabilities(i), timestamp);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::processJoystickState(unsigned int index, const JoystickState& state, const JoystickCaps& caps, Int64 timestamp)
+{
+    // Copy the previous state of the joystick and store the new one
+    JoystickState previousState = m_joystickStates[index];
+    m_joystickStates[index] = state;
+
+    // Connection state
+    bool connected = state.connected;
+    if (previousState.connected ^ connected)
+    {
+        Event event;
+        event.type = connected ? Event::JoystickConnected : Event::JoystickDisconnected;
+        event.joystickConnect.joystickId = index;
+        event.joystickConnect.timestamp = timestamp;
+        pushEvent(event);
+    }
+
+    if (connected)
+    {
+        // Axes
+        for (unsigned int j = 0; j < Joystick::AxisCount; ++j)
         {
-            // Axes
-            for (unsigned int j = 0; j < Joystick::AxisCount; ++j)
+            if (caps.axes[j])
             {
-                if (caps.axes[j])
+                Joystick::Axis axis = static_cast<Joystick::Axis>(j);
+                float prevPos = previousState.axes[axis];
+                float currPos = state.axes[axis];
+                if (fabs(currPos - prevPos) >= m_joystickThreshold)
                 {
-                    Joystick::Axis axis = static_cast<Joystick::Axis>(j);
-                    float prevPos = previousState.axes[axis];
-                    float currPos = m_joystickStates[i].axes[axis];
-                    if (fabs(currPos - prevPos) >= m_joystickThreshold)
-                    {
-                        Event event;
-                        event.type = Event::JoystickMoved;
-                        event.joystickMove.joystickId = i;
-                        event.joystickMove.axis = axis;
-                        event.joystickMove.position = currPos;
-                        pushEvent(event);
-                    }
+                    Event event;
+                    event.type = Event::JoystickMoved;
+                    event.joystickMove.joystickId = index;
+                    event.joystickMove.axis = axis;
+                    event.joystickMove.position = currPos;
+                    event.joystickMove.timestamp = timestamp;
+                    pushEvent(event);
                 }
             }
+        }
 
-            // Buttons
-            for (unsigned int j = 0; j < caps.buttonCount; ++j)
-            {
-                bool prevPressed = previousState.buttons[j];
-                bool currPressed = m_joystickStates[i].buttons[j];
+        // Buttons
+        for (unsigned int j = 0; j < caps.buttonCount; ++j)
+        {
+            bool prevPressed = previousState.buttons[j];
+            bool currPressed = state.buttons[j];
 
-                if (prevPressed ^ currPressed)
-                {
-                    Event event;
-                    event.type = currPressed ? Event::JoystickButtonPressed : Event::JoystickButtonReleased;
-                    event.joystickButton.joystickId = i;
-                    event.joystickButton.button = j;
-                    pushEvent(event);
-                }
+            if (prevPressed ^ currPressed)
+            {
+                Event event;
+                event.type = currPressed ? Event::JoystickButtonPressed : Event::JoystickButtonReleased;
+                event.joystickButton.joystickId = index;
+                event.joystickButton.button = j;
+                event.joystickButton.timestamp = timestamp;
+                pushEvent(event);
             }
         }
     }
@@ -31,6 +31,7 @@
 #include <SFML/Config.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
@@ -112,6 +113,17 @@ public:
     ////////////////////////////////////////////////////////////
     bool popEvent(Event& event, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next window event, waiting at most a given time
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event
+    ///
+    /// \return True if an event was returned, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popEvent(Event& event, Time timeout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -235,14 +247,52 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    /// This function returns when the operating system, the
+    /// joysticks or the sensors may have new events, or when
+    /// the timeout expires. It may return early, the caller
+    /// processes the events and waits again if there's none.
+    /// The default implementation sleeps for at most 10
+    /// milliseconds, so that the devices are polled regularly.
+    ///
+    /// \param timeout Maximum time to wait, or a negative time to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next window event, waiting if necessary
+    ///
+    /// \param event   Event to be returned
+    /// \param block   Wait for an event if the queue is empty?
+    /// \param timeout Maximum time to wait, or a negative time to wait without limit
+    ///
+    /// \return True if an event was returned
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popEvent(Event& event, bool block, Time timeout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Read the joysticks state and generate the appropriate events
     ///
     ////////////////////////////////////////////////////////////
     void processJoystickEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate the events for a new state of a joystick
+    ///
+    /// \param index     Index of the joystick
+    /// \param state     New state of the joystick
+    /// \param caps      Capabilities of the joystick
+    /// \param timestamp Time of the new state, in microseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    void processJoystickState(unsigned int index, const JoystickState& state, const JoystickCaps& caps, Int64 timestamp);
+
     ////////////////////////////////////////////////////////////
     /// \brief Read the sensors state and generate the appropriate events
     ///
@@ -254,6 +304,7 @@ private:
     ////////////////////////////////////////////////////////////
     std::queue<Event> m_events;                          ///< Queue of available events
     JoystickState     m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
+    Uint64            m_nextJoystickSample;              ///< Sequence number of the next joystick sample to process
     Vector3f          m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
     float             m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
 };